@@ -0,0 +1,104 @@
+// bench.cpp
+// Mesures de performance (Catch2) : à compiler avec -O2, séparément des tests
+#include "catch_amalgamated.hpp"
+#include "components/Grid.h"
+#include "components/AliveCell.h"
+#include "services/BinarySave.h"
+#include "services/Game.h"
+#include "services/TextSave.h"
+#include <cstdio>
+#include <random>
+#include <string>
+
+using namespace GameOfLife;
+
+namespace {
+
+// Soupe aléatoire dans le coin supérieur gauche : l'activité reste locale
+// quelle que soit la taille du plateau
+void seedCorner(Grid& grid, unsigned seed) {
+    std::mt19937 random(seed);
+    for (int y = 0; y < 48; ++y) {
+        for (int x = 0; x < 48; ++x) {
+            if (random() % 3 == 0) {
+                grid.setCellCode(x, y, AliveCode);
+            }
+        }
+    }
+}
+
+// Soupe aléatoire sur tout le plateau, une cellule sur density vivante
+Grid randomGrid(int width, int height, unsigned density, unsigned seed) {
+    Grid grid(width, height);
+    std::mt19937 random(seed);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (random() % density == 0) {
+                grid.setCellCode(x, y, AliveCode);
+            }
+        }
+    }
+    return grid;
+}
+
+}
+
+// L'annulation échange des pointeurs : son coût ne doit pas suivre la taille du
+// plateau, contrairement à la copie de la grille donnée en référence
+TEST_CASE("Undo and redo cost does not depend on the board size", "[Timeline]") {
+    for (int size : {64, 512, 4096}) {
+        Game game(size, size, 1000000);
+        seedCorner(game.getGrid(), 3);
+        for (int i = 0; i < 40; ++i) {
+            game.step();
+        }
+        const std::string board = std::to_string(size) + "x" + std::to_string(size);
+
+        BENCHMARK("undo + redo " + board) {
+            game.undo();
+            game.redo();
+            return game.getGrid().getWidth();
+        };
+        BENCHMARK("copie de la grille " + board) {
+            Grid copy = game.getGrid();
+            return copy.getWidth();
+        };
+    }
+}
+
+// Format binaire contre format texte, sur une soupe dense et sur un grand
+// plateau presque vide (tuiles vides partagées)
+TEST_CASE("Binary save against text save", "[BinarySave]") {
+    struct Board {
+        const char* name;
+        Grid grid;
+    };
+    Board boards[] = {
+        {"soupe 1000x700", randomGrid(1000, 700, 3, 5)},
+        {"clairsemé 4096x4096", randomGrid(4096, 4096, 5000, 6)},
+    };
+    const std::string binaryPath = "bench_save.golb";
+    const std::string textPath = "bench_save.txt";
+    for (Board& board : boards) {
+        const std::string name = board.name;
+        Grid loaded(1, 1);
+        uint64_t generation = 0;
+
+        BENCHMARK("écriture binaire " + name) {
+            return BinarySave::write(binaryPath, board.grid, 0);
+        };
+        BENCHMARK("écriture texte " + name) {
+            return TextSave::write(textPath, board.grid);
+        };
+        BENCHMARK("lecture binaire " + name) {
+            return BinarySave::read(binaryPath, loaded, generation);
+        };
+        REQUIRE(loaded == board.grid);
+        BENCHMARK("lecture texte " + name) {
+            return TextSave::read(textPath, loaded);
+        };
+        REQUIRE(loaded == board.grid);
+    }
+    std::remove(binaryPath.c_str());
+    std::remove(textPath.c_str());
+}
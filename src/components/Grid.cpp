@@ -1,70 +1,229 @@
 // Grid.cpp
 #include "components/Grid.h"
 #include "components/DeadObstacleCell.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <iostream>
 #include <thread>
 #include <vector>
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
 namespace GameOfLife {
 
-Grid::Grid(int width, int height)
-    : width(width), height(height), toroidal(false) {
-    cells.resize(width);
-    for (int x = 0; x < width; ++x) {
-        cells[x].resize(height);
-        for (int y = 0; y < height; ++y) {
-            cells[x][y] = new DeadCell();
-        }
+namespace {
+
+// Instances partagées renvoyées par getCell (les cellules ne sont plus allouées une à une)
+AliveCell aliveFlyweight;
+DeadCell deadFlyweight;
+ObstacleCell obstacleAliveFlyweight(true);
+ObstacleCell obstacleDeadFlyweight(false);
+DeadObstacleCell deadObstacleFlyweight;
+
+std::atomic<unsigned> threadCount(0);  // 0 : un thread par cœur
+
+inline int popcount(uint64_t value) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(value);
+#else
+    value = value - ((value >> 1) & 0x5555555555555555ULL);
+    value = (value & 0x3333333333333333ULL) + ((value >> 2) & 0x3333333333333333ULL);
+    value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<int>((value * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define GAMEOFLIFE_GRID_POPCNT
+#define GAMEOFLIFE_ALWAYS_INLINE __attribute__((always_inline))
+#else
+#define GAMEOFLIFE_ALWAYS_INLINE
+#endif
+
+// Compare deux états d'une tuile en comptant les cellules nées et mortes ;
+// faux si la tuile est inchangée
+inline GAMEOFLIFE_ALWAYS_INLINE bool countTileChanges(const uint64_t* next, const uint64_t* previous,
+                                                      int& created, int& destroyed) {
+    // Sans test par ligne : dans une zone active, il serait mal prédit
+    uint64_t any = 0;
+    int born = 0;
+    int died = 0;
+    for (int r = 0; r < Grid::TileSize; ++r) {
+        uint64_t diff = next[r] ^ previous[r];
+        born += popcount(diff & next[r]);
+        died += popcount(diff & previous[r]);
+        any |= diff;
     }
+    created += born;
+    destroyed += died;
+    return any != 0;
 }
 
-Grid::Grid(const Grid& other)
-    : width(other.width), height(other.height), toroidal(other.toroidal) {
-    cells.resize(width);
-    for (int x = 0; x < width; ++x) {
-        cells[x].resize(height);
-        for (int y = 0; y < height; ++y) {
-            cells[x][y] = other.cells[x][y]->clone();
+#ifdef GAMEOFLIFE_GRID_POPCNT
+// Même boucle avec l'instruction popcnt, choisie à l'exécution : sans elle,
+// chaque comptage passe par une fonction de la bibliothèque du compilateur
+__attribute__((target("popcnt")))
+bool countTileChangesPopcnt(const uint64_t* next, const uint64_t* previous, int& created, int& destroyed) {
+    return countTileChanges(next, previous, created, destroyed);
+}
+
+// Population de chaque octet d'un vecteur, par une table des 16 quartets
+__attribute__((target("avx2")))
+inline __m256i popcountBytes(__m256i value, __m256i table, __m256i lowNibbles) {
+    return _mm256_add_epi8(_mm256_shuffle_epi8(table, _mm256_and_si256(value, lowNibbles)),
+                           _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(value, 4), lowNibbles)));
+}
+
+__attribute__((target("avx2")))
+int64_t sumBytes(__m256i counts) {
+    __m256i sums = _mm256_sad_epu8(counts, _mm256_setzero_si256());
+    return _mm256_extract_epi64(sums, 0) + _mm256_extract_epi64(sums, 1) +
+           _mm256_extract_epi64(sums, 2) + _mm256_extract_epi64(sums, 3);
+}
+
+// Même comptage quatre lignes à la fois avec AVX2 (popcnt n'existe pas sur
+// les vecteurs). Chaque octet des compteurs reçoit au plus 8 par passage,
+// soit 128 sur une tuile : ils ne sont sommés qu'à la fin.
+__attribute__((target("avx2")))
+bool countTileChangesAvx2(const uint64_t* next, const uint64_t* previous, int& created, int& destroyed) {
+    static_assert(Grid::TileSize / 4 * 8 <= 255, "compteurs d'octets");
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i lowNibbles = _mm256_set1_epi8(0x0F);
+    __m256i any = _mm256_setzero_si256();
+    __m256i born = _mm256_setzero_si256();
+    __m256i died = _mm256_setzero_si256();
+    for (int r = 0; r < Grid::TileSize; r += 4) {
+        __m256i after = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(next + r));
+        __m256i before = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(previous + r));
+        any = _mm256_or_si256(any, _mm256_xor_si256(after, before));
+        born = _mm256_add_epi8(born, popcountBytes(_mm256_andnot_si256(before, after), table, lowNibbles));
+        died = _mm256_add_epi8(died, popcountBytes(_mm256_andnot_si256(after, before), table, lowNibbles));
+    }
+    created += static_cast<int>(sumBytes(born));
+    destroyed += static_cast<int>(sumBytes(died));
+    return !_mm256_testz_si256(any, any);
+}
+
+bool detectPopcnt() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("popcnt");
+}
+
+bool detectAvx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+const bool hasPopcnt = detectPopcnt();
+const bool hasAvx2 = detectAvx2();
+#endif
+
+bool isEmpty(const Grid::Tile& tile) {
+    for (int r = 0; r < Grid::TileSize; ++r) {
+        if (tile.alive[r] | tile.obstacle[r] | tile.deadObstacle[r]) {
+            return false;
         }
     }
+    return true;
+}
+
+}
+
+const int Grid::TileSize;
+const int Grid::MaxDimension;
+const uint16_t Grid::ConwayBirth;
+const uint16_t Grid::ConwaySurvival;
+
+Grid::Grid(int width, int height)
+    : width(std::min(std::max(width, 0), MaxDimension)), height(std::min(std::max(height, 0), MaxDimension)),
+      toroidal(false),
+      birthMask(ConwayBirth), survivalMask(ConwaySurvival) {
+    tilesX = (this->width + TileSize - 1) / TileSize;
+    tilesY = (this->height + TileSize - 1) / TileSize;
+    tiles.assign(static_cast<size_t>(tilesX) * tilesY, emptyTile());
+    activeTiles.assign(tiles.size(), 1);
+    revision = nextRevision();
+}
+
+Grid::Grid(const Grid& other)
+    : width(other.width), height(other.height), toroidal(other.toroidal),
+      birthMask(other.birthMask), survivalMask(other.survivalMask),
+      tilesX(other.tilesX), tilesY(other.tilesY),
+      tiles(other.tiles), activeTiles(other.activeTiles), revision(other.revision) {
+}
+
+Grid::Grid(Grid&& other) noexcept
+    : width(other.width), height(other.height), toroidal(other.toroidal),
+      birthMask(other.birthMask), survivalMask(other.survivalMask),
+      tilesX(other.tilesX), tilesY(other.tilesY),
+      tiles(std::move(other.tiles)), activeTiles(std::move(other.activeTiles)), revision(other.revision) {
+    // La grille source devient vide mais reste utilisable
+    other.width = other.height = other.tilesX = other.tilesY = 0;
+    other.tiles.clear();
+    other.activeTiles.clear();
+    other.revision = nextRevision();
 }
 
 Grid& Grid::operator=(const Grid& other) {
     if (this != &other) {
-        // Supprimer les cellules existantes
-        for (int x = 0; x < width; ++x) {
-            for (int y = 0; y < height; ++y) {
-                delete cells[x][y];
-            }
-        }
-        cells.clear();
-
-        // Copier les dimensions et le mode torique
+        // Seuls les pointeurs de tuiles sont copiés
         width = other.width;
         height = other.height;
         toroidal = other.toroidal;
+        birthMask = other.birthMask;
+        survivalMask = other.survivalMask;
+        tilesX = other.tilesX;
+        tilesY = other.tilesY;
+        tiles = other.tiles;
+        activeTiles = other.activeTiles;
+        revision = other.revision;
+    }
+    return *this;
+}
 
-        // Copie profonde des cellules
-        cells.resize(width);
-        for (int x = 0; x < width; ++x) {
-            cells[x].resize(height);
-            for (int y = 0; y < height; ++y) {
-                cells[x][y] = other.cells[x][y]->clone();
-            }
-        }
+Grid& Grid::operator=(Grid&& other) noexcept {
+    if (this != &other) {
+        Grid moved(std::move(other));
+        swap(moved);
     }
     return *this;
 }
 
+void Grid::swap(Grid& other) noexcept {
+    std::swap(width, other.width);
+    std::swap(height, other.height);
+    std::swap(toroidal, other.toroidal);
+    std::swap(birthMask, other.birthMask);
+    std::swap(survivalMask, other.survivalMask);
+    std::swap(tilesX, other.tilesX);
+    std::swap(tilesY, other.tilesY);
+    tiles.swap(other.tiles);
+    activeTiles.swap(other.activeTiles);
+    std::swap(revision, other.revision);
+}
+
+uint64_t Grid::nextRevision() {
+    static std::atomic<uint64_t> counter(0);
+    return ++counter;
+}
+
 Grid::~Grid() {
-    for (int x = 0; x < width; ++x) {
-        for (int y = 0; y < height; ++y) {
-            delete cells[x][y];
-        }
-    }
+}
+
+const std::shared_ptr<Grid::Tile>& Grid::emptyTile() {
+    static const std::shared_ptr<Tile> empty = std::make_shared<Tile>();
+    return empty;
 }
 
 void Grid::setToroidal(bool value) {
+    if (toroidal != value) {
+        // Les bords changent de voisinage : tout recalculer
+        markAllActive();
+        revision = nextRevision();
+    }
     toroidal = value;
 }
 
@@ -72,135 +231,452 @@ bool Grid::isToroidal() const {
     return toroidal;
 }
 
-void Grid::update() {
-    std::vector<std::vector<Cell*>> nextCells(width, std::vector<Cell*>(height, nullptr));
-
-    const int numThreads = std::thread::hardware_concurrency();
-    std::vector<std::thread> threads;
-    int rowsPerThread = height / numThreads;
+void Grid::setRule(uint16_t birth, uint16_t survival) {
+    birth &= 0x1FF;
+    survival &= 0x1FF;
+    if (birth != birthMask || survival != survivalMask) {
+        markAllActive();
+        revision = nextRevision();
+    }
+    birthMask = birth;
+    survivalMask = survival;
+}
 
-    auto updateRange = [this, &nextCells](int startRow, int endRow) {
-        for (int x = 0; x < width; ++x) {
-            for (int y = startRow; y < endRow; ++y) {
-                Cell* currentCell = cells[x][y];
+std::string Grid::getRuleString() const {
+    std::string rule = "B";
+    for (int n = 0; n <= 8; ++n) {
+        if ((birthMask >> n) & 1) {
+            rule += static_cast<char>('0' + n);
+        }
+    }
+    rule += "/S";
+    for (int n = 0; n <= 8; ++n) {
+        if ((survivalMask >> n) & 1) {
+            rule += static_cast<char>('0' + n);
+        }
+    }
+    return rule;
+}
 
-                if (dynamic_cast<ObstacleCell*>(currentCell)) {
-                    nextCells[x][y] = currentCell->clone();
-                    continue;
+bool Grid::parseRule(const std::string& text, uint16_t& birth, uint16_t& survival) {
+    // Notations acceptées : "B3/S23" (ordre et casse libres) ou "23/3" (survie/naissance)
+    size_t slash = text.find('/');
+    if (slash == std::string::npos) {
+        return false;
+    }
+    std::string parts[2] = {text.substr(0, slash), text.substr(slash + 1)};
+    uint16_t masks[2] = {0, 0};
+    char kinds[2] = {0, 0};
+    for (int i = 0; i < 2; ++i) {
+        for (char c : parts[i]) {
+            if (c == 'B' || c == 'b' || c == 'S' || c == 's') {
+                if (kinds[i] != 0) {
+                    return false;
                 }
-
-                int aliveNeighbors = countAliveNeighbors(x, y);
-                Cell* nextCell = currentCell->nextState(aliveNeighbors);
-                nextCells[x][y] = nextCell;
+                kinds[i] = static_cast<char>(c == 'b' || c == 'B' ? 'B' : 'S');
+            } else if (c >= '0' && c <= '8') {
+                masks[i] |= static_cast<uint16_t>(1 << (c - '0'));
+            } else if (c != ' ') {
+                return false;
             }
         }
-    };
+    }
+    if (kinds[0] == 0 && kinds[1] == 0) {
+        survival = masks[0];
+        birth = masks[1];
+        return true;
+    }
+    if (kinds[0] == 0 || kinds[1] == 0 || kinds[0] == kinds[1]) {
+        return false;
+    }
+    birth = kinds[0] == 'B' ? masks[0] : masks[1];
+    survival = kinds[0] == 'B' ? masks[1] : masks[0];
+    return true;
+}
 
-    for (int i = 0; i < numThreads; ++i) {
-        int startRow = i * rowsPerThread;
-        int endRow = (i == numThreads - 1) ? height : startRow + rowsPerThread;
-        threads.emplace_back(updateRange, startRow, endRow);
+uint64_t Grid::countableRow(int tx, int gy) const {
+    if (gy < 0 || gy >= height) {
+        if (!toroidal || height == 0) {
+            return 0;
+        }
+        gy = (gy % height + height) % height;
     }
+    const Tile& tile = *tiles[(gy / TileSize) * tilesX + tx];
+    int r = gy % TileSize;
+    // Les obstacles ne comptent jamais comme voisins vivants
+    return tile.alive[r] & ~tile.obstacle[r];
+}
 
-    for (auto& t : threads) {
-        t.join();
+uint64_t Grid::countableBit(int gx, int gy) const {
+    if (gx < 0 || gx >= width) {
+        if (!toroidal || width == 0) {
+            return 0;
+        }
+        gx = (gx % width + width) % width;
     }
+    return (countableRow(gx / TileSize, gy) >> (gx % TileSize)) & 1;
+}
 
-    // Mise à jour de la grille avec les nouvelles cellules
-    for (int x = 0; x < width; ++x) {
-        for (int y = 0; y < height; ++y) {
-            delete cells[x][y];
-            cells[x][y] = nextCells[x][y];
+bool Grid::needsUpdate(int tx, int ty) const {
+    // Une tuile dont aucune voisine n'a changé ne peut pas changer
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            int nx = tx + dx;
+            int ny = ty + dy;
+            if (toroidal) {
+                nx = (nx + tilesX) % tilesX;
+                ny = (ny + tilesY) % tilesY;
+            } else if (nx < 0 || nx >= tilesX || ny < 0 || ny >= tilesY) {
+                continue;
+            }
+            if (activeTiles[ny * tilesX + nx]) {
+                return true;
+            }
         }
     }
+    return false;
 }
 
-int Grid::countAliveNeighbors(int x, int y) const {
-    static const int dx[] = { -1, -1, -1, 0, 0, 1, 1, 1 };
-    static const int dy[] = { -1, 0, 1, -1, 1, -1, 0, 1 };
+void Grid::computeTile(int tx, int ty, Tile& next) const {
+    const Tile& current = *tiles[ty * tilesX + tx];
+    const int x0 = tx * TileSize;
+    const int y0 = ty * TileSize;
+    const int tileWidth = std::min(TileSize, width - x0);
+    const int tileHeight = std::min(TileSize, height - y0);
+    const uint64_t validMask = tileWidth == TileSize ? ~0ULL : ((1ULL << tileWidth) - 1);
+
+    std::memcpy(next.obstacle, current.obstacle, sizeof(next.obstacle));
+    std::memcpy(next.deadObstacle, current.deadObstacle, sizeof(next.deadObstacle));
+    std::memset(next.alive, 0, sizeof(next.alive));
+
+    for (int r = 0; r < tileHeight; ++r) {
+        const int gy = y0 + r;
+
+        // Compteur de voisins sur 4 plans de bits (64 cellules à la fois)
+        uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        auto add = [&](uint64_t a) {
+            uint64_t c0 = s0 & a;
+            s0 ^= a;
+            uint64_t c1 = s1 & c0;
+            s1 ^= c0;
+            uint64_t c2 = s2 & c1;
+            s2 ^= c1;
+            s3 |= c2;
+        };
+
+        for (int dy = -1; dy <= 1; ++dy) {
+            uint64_t row = countableRow(tx, gy + dy);
+            uint64_t west = countableBit(x0 - 1, gy + dy);
+            uint64_t east = countableBit(x0 + tileWidth, gy + dy);
+            add((row << 1) | west);
+            add((row >> 1) | (east << (tileWidth - 1)));
+            if (dy != 0) {
+                add(row);
+            }
+        }
 
-    int count = 0;
+        const uint64_t self = current.alive[r] & ~current.obstacle[r];
+        uint64_t result = 0;
+        for (int n = 0; n <= 8; ++n) {
+            if (!(((birthMask | survivalMask) >> n) & 1)) {
+                continue;
+            }
+            uint64_t equal = ((n & 1) ? s0 : ~s0) & ((n & 2) ? s1 : ~s1) &
+                             ((n & 4) ? s2 : ~s2) & ((n & 8) ? s3 : ~s3);
+            uint64_t selected = 0;
+            if ((birthMask >> n) & 1) {
+                selected |= ~self;
+            }
+            if ((survivalMask >> n) & 1) {
+                selected |= self;
+            }
+            result |= equal & selected;
+        }
 
-    for (int i = 0; i < 8; ++i) {
-        int nx = x + dx[i];
-        int ny = y + dy[i];
+        // Les obstacles conservent leur état
+        next.alive[r] = ((result & ~current.obstacle[r]) | (current.alive[r] & current.obstacle[r])) & validMask;
+    }
+}
 
-        if (toroidal) {
-            nx = (nx + width) % width;
-            ny = (ny + height) % height;
-        } else {
-            if (nx < 0 || nx >= width || ny < 0 || ny >= height) {
-                continue;
+void Grid::update() {
+    advance(nullptr, nullptr);
+}
+
+void Grid::update(int& created, int& destroyed) {
+    advance(&created, &destroyed);
+}
+
+void Grid::advance(int* created, int* destroyed) {
+    std::vector<std::shared_ptr<Tile>> nextTiles(tiles.size());
+    std::vector<uint8_t> nextActive(tiles.size(), 0);
+
+    // Seules les tuiles proches d'un changement sont recalculées
+    std::vector<int> work;
+    for (int ty = 0; ty < tilesY; ++ty) {
+        for (int tx = 0; tx < tilesX; ++tx) {
+            int index = ty * tilesX + tx;
+            if (needsUpdate(tx, ty)) {
+                work.push_back(index);
+            } else {
+                nextTiles[index] = tiles[index];
             }
         }
+    }
 
-        Cell* neighborCell = cells[nx][ny];
-        if (dynamic_cast<ObstacleCell*>(neighborCell)) {
-            continue;
+    std::atomic<size_t> nextWork(0);
+    std::atomic<int> totalCreated(0);
+    std::atomic<int> totalDestroyed(0);
+    const bool counting = created != nullptr;
+    auto updateRange = [this, &work, &nextWork, &nextTiles, &nextActive, &totalCreated, &totalDestroyed, counting]() {
+        Tile next;
+        int localCreated = 0;
+        int localDestroyed = 0;
+        for (size_t i = nextWork++; i < work.size(); i = nextWork++) {
+            int index = work[i];
+            computeTile(index % tilesX, index / tilesX, next);
+
+            // Comptage fait pendant la comparaison, sur des lignes encore en cache
+            const uint64_t* previous = tiles[index]->alive;
+            bool changed;
+            if (!counting) {
+                changed = std::memcmp(next.alive, previous, sizeof(next.alive)) != 0;
+#ifdef GAMEOFLIFE_GRID_POPCNT
+            } else if (hasAvx2) {
+                changed = countTileChangesAvx2(next.alive, previous, localCreated, localDestroyed);
+            } else if (hasPopcnt) {
+                changed = countTileChangesPopcnt(next.alive, previous, localCreated, localDestroyed);
+#endif
+            } else {
+                changed = countTileChanges(next.alive, previous, localCreated, localDestroyed);
+            }
+
+            if (!changed) {
+                // Tuile inchangée : elle reste partagée avec la génération précédente
+                nextTiles[index] = tiles[index];
+            } else {
+                nextTiles[index] = isEmpty(next) ? emptyTile() : std::make_shared<Tile>(next);
+                nextActive[index] = 1;
+            }
         }
+        totalCreated += localCreated;
+        totalDestroyed += localDestroyed;
+    };
 
-        if (neighborCell->isAlive()) {
-            count++;
+    size_t numThreads = getThreadCount();
+    numThreads = std::min(numThreads, work.size());
+    if (numThreads <= 1) {
+        updateRange();
+    } else {
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < numThreads; ++i) {
+            threads.emplace_back(updateRange);
+        }
+        for (auto& t : threads) {
+            t.join();
         }
     }
 
-    return count;
+    // Mise à jour de la grille avec les nouvelles tuiles
+    tiles.swap(nextTiles);
+    activeTiles.swap(nextActive);
+    revision = nextRevision();
+    if (counting) {
+        *created = totalCreated;
+        *destroyed = totalDestroyed;
+    }
+}
+
+void Grid::setThreadCount(unsigned count) {
+    threadCount = count;
+}
+
+unsigned Grid::getThreadCount() {
+    unsigned count = threadCount;
+    return count != 0 ? count : std::max(1u, std::thread::hardware_concurrency());
 }
 
 void Grid::print() const {
     for (int y = 0; y < height; ++y) {
         for (int x = 0; x < width; ++x) {
-            std::cout << (cells[x][y]->isAlive() ? "O" : ".");
+            std::cout << ((getCellCode(x, y) == AliveCode || getCellCode(x, y) == ObstacleAliveCode) ? "O" : ".");
         }
         std::cout << std::endl;
     }
 }
 
+uint8_t Grid::getCellCode(int x, int y) const {
+    const Tile& tile = *tiles[(y / TileSize) * tilesX + x / TileSize];
+    int r = y % TileSize;
+    uint64_t bit = 1ULL << (x % TileSize);
+    if (tile.obstacle[r] & bit) {
+        if (tile.deadObstacle[r] & bit) {
+            return DeadObstacleCode;
+        }
+        return (tile.alive[r] & bit) ? ObstacleAliveCode : ObstacleDeadCode;
+    }
+    return (tile.alive[r] & bit) ? AliveCode : DeadCode;
+}
+
+void Grid::setCellCode(int x, int y, uint8_t code) {
+    if (x < 0 || x >= width || y < 0 || y >= height) {
+        return;
+    }
+    Tile& tile = getMutableTile((y / TileSize) * tilesX + x / TileSize);
+    int r = y % TileSize;
+    uint64_t bit = 1ULL << (x % TileSize);
+
+    bool alive = (code == AliveCode || code == ObstacleAliveCode);
+    bool obstacle = (code == ObstacleDeadCode || code == ObstacleAliveCode || code == DeadObstacleCode);
+    tile.alive[r] = alive ? (tile.alive[r] | bit) : (tile.alive[r] & ~bit);
+    tile.obstacle[r] = obstacle ? (tile.obstacle[r] | bit) : (tile.obstacle[r] & ~bit);
+    tile.deadObstacle[r] = (code == DeadObstacleCode) ? (tile.deadObstacle[r] | bit) : (tile.deadObstacle[r] & ~bit);
+}
+
 Cell* Grid::getCell(int x, int y) const {
     if (x >= 0 && x < width && y >= 0 && y < height) {
-        return cells[x][y];
+        switch (getCellCode(x, y)) {
+            case AliveCode:         return &aliveFlyweight;
+            case ObstacleDeadCode:  return &obstacleDeadFlyweight;
+            case ObstacleAliveCode: return &obstacleAliveFlyweight;
+            case DeadObstacleCode:  return &deadObstacleFlyweight;
+            default:                return &deadFlyweight;
+        }
     }
     return nullptr;
 }
 
 void Grid::setCell(int x, int y, Cell* cell) {
-    if (x >= 0 && x < width && y >= 0 && y < height) {
-        delete cells[x][y];
-        cells[x][y] = cell;
+    // La grille prend possession de la cellule : seul son état est conservé
+    uint8_t code;
+    if (dynamic_cast<ObstacleCell*>(cell)) {
+        code = cell->isAlive() ? ObstacleAliveCode : ObstacleDeadCode;
+    } else if (dynamic_cast<DeadObstacleCell*>(cell)) {
+        code = DeadObstacleCode;
+    } else {
+        code = cell->isAlive() ? AliveCode : DeadCode;
     }
+    delete cell;
+    setCellCode(x, y, code);
 }
 
 void Grid::toggleCellState(int x, int y) {
     if (x >= 0 && x < width && y >= 0 && y < height) {
-        Cell* currentCell = cells[x][y];
-        if (dynamic_cast<ObstacleCell*>(currentCell)) {
+        uint8_t code = getCellCode(x, y);
+        if (code == ObstacleDeadCode || code == ObstacleAliveCode) {
             // Ne pas basculer les cellules obstacles avec le clic gauche
             return;
         }
-        Cell* newCell;
-        if (currentCell->isAlive()) {
-            newCell = new DeadCell();
-        } else {
-            newCell = new AliveCell();
-        }
-        delete currentCell;
-        cells[x][y] = newCell;
+        setCellCode(x, y, code == AliveCode ? DeadCode : AliveCode);
     }
 }
 
 void Grid::clearGrid() {
-    for (int x = 0; x < width; ++x) {
-        for (int y = 0; y < height; ++y) {
-            delete cells[x][y];
-            cells[x][y] = new DeadCell();
+    std::fill(tiles.begin(), tiles.end(), emptyTile());
+    markAllActive();
+    revision = nextRevision();
+}
+
+void Grid::setObstacle(int x, int y, bool isAlive) {
+    setCellCode(x, y, isAlive ? ObstacleAliveCode : ObstacleDeadCode);
+}
+
+std::vector<uint8_t> Grid::getStateCodes() const {
+    std::vector<uint8_t> codes(static_cast<size_t>(width) * height, DeadCode);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            codes[static_cast<size_t>(y) * width + x] = getCellCode(x, y);
         }
     }
+    return codes;
 }
 
-void Grid::setObstacle(int x, int y, bool isAlive) {
-    if (x >= 0 && x < width && y >= 0 && y < height) {
-        delete cells[x][y];
-        cells[x][y] = new ObstacleCell(isAlive);
+void Grid::setStateCodes(const std::vector<uint8_t>& codes) {
+    if (codes.size() != static_cast<size_t>(width) * height) {
+        return;
+    }
+    clearGrid();
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            uint8_t code = codes[static_cast<size_t>(y) * width + x];
+            if (code != DeadCode) {
+                setCellCode(x, y, code);
+            }
+        }
+    }
+}
+
+Grid::Tile& Grid::getMutableTile(int index) {
+    // Copie sur écriture : une tuile partagée est dupliquée avant modification
+    if (tiles[index].use_count() > 1) {
+        tiles[index] = std::make_shared<Tile>(*tiles[index]);
+    }
+    activeTiles[index] = 1;
+    revision = nextRevision();
+    return *tiles[index];
+}
+
+void Grid::markAllActive() {
+    std::fill(activeTiles.begin(), activeTiles.end(), 1);
+}
+
+bool Grid::sharesTile(const Grid& other, int index) const {
+    return tiles[index] == other.tiles[index];
+}
+
+void Grid::setSharedTile(int index, const std::shared_ptr<Tile>& tile) {
+    tiles[index] = tile;
+}
+
+void Grid::replaceTile(int index, const std::shared_ptr<Tile>& tile) {
+    tiles[index] = tile;
+    activeTiles[index] = 1;
+    revision = nextRevision();
+}
+
+int Grid::countSharedTiles(const Grid& other) const {
+    if (width != other.width || height != other.height) {
+        return 0;
+    }
+    int shared = 0;
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        if (tiles[i] == other.tiles[i]) {
+            ++shared;
+        }
+    }
+    return shared;
+}
+
+int Grid::countAlive() const {
+    int count = 0;
+    for (const auto& tile : tiles) {
+        if (tile == emptyTile()) {
+            continue;
+        }
+        for (int r = 0; r < TileSize; ++r) {
+            count += popcount(tile->alive[r]);
+        }
+    }
+    return count;
+}
+
+int Grid::countChangedTiles() const {
+    return static_cast<int>(std::count(activeTiles.begin(), activeTiles.end(), 1));
+}
+
+void Grid::countChanges(const Grid& previous, int& created, int& destroyed) const {
+    created = 0;
+    destroyed = 0;
+    if (width != previous.width || height != previous.height) {
+        return;
+    }
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        if (tiles[i] == previous.tiles[i]) {
+            continue; // Tuile partagée : aucun changement
+        }
+        for (int r = 0; r < TileSize; ++r) {
+            created += popcount(tiles[i]->alive[r] & ~previous.tiles[i]->alive[r]);
+            destroyed += popcount(previous.tiles[i]->alive[r] & ~tiles[i]->alive[r]);
+        }
     }
 }
 
@@ -208,11 +684,10 @@ bool Grid::operator==(const Grid& other) const {
     if (width != other.width || height != other.height) {
         return false;
     }
-    for (int x = 0; x < width; ++x) {
-        for (int y = 0; y < height; ++y) {
-            if (cells[x][y]->isAlive() != other.cells[x][y]->isAlive()) {
-                return false;
-            }
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        if (tiles[i] != other.tiles[i] &&
+            std::memcmp(tiles[i]->alive, other.tiles[i]->alive, sizeof(tiles[i]->alive)) != 0) {
+            return false;
         }
     }
     return true;
@@ -1,6 +1,9 @@
 // Grid.h
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <string>
 #include <vector>
 #include "components/Cell.h"
 #include "components/AliveCell.h"
@@ -9,14 +12,48 @@
 
 namespace GameOfLife {
 
+// Code compact de l'état d'une cellule (un octet par cellule)
+enum CellCode : uint8_t {
+    DeadCode = 0,
+    AliveCode = 1,
+    ObstacleDeadCode = 2,
+    ObstacleAliveCode = 3,
+    DeadObstacleCode = 4
+};
+
+// La grille est découpée en tuiles de TileSize x TileSize cellules stockées
+// en plans de bits. Les tuiles sont partagées entre copies (copie sur écriture) :
+// copier une grille ne copie que les pointeurs, et une modification ne
+// duplique que la tuile touchée.
 class Grid {
 public:
+    static const int TileSize = 64;
+    static const int MaxDimension = 1 << 30;  // Côté maximal, en cellules
+
+    struct Tile {
+        uint64_t alive[TileSize];         // Bit x de la ligne y : cellule vivante
+        uint64_t obstacle[TileSize];      // Cellule immuable (obstacle)
+        uint64_t deadObstacle[TileSize];  // Obstacle de type DeadObstacleCell
+    };
+
     Grid(int width, int height);
     Grid(const Grid& other);
+    Grid(Grid&& other) noexcept;
     Grid& operator=(const Grid& other);
+    Grid& operator=(Grid&& other) noexcept;
     ~Grid();
 
+    void swap(Grid& other) noexcept;
+
+    // Identifiant du contenu : change à chaque modification, conservé par copie
+    uint64_t getRevision() const { return revision; }
+
     void update();
+    // Même calcul, en comptant au passage les cellules nées et mortes
+    void update(int& created, int& destroyed);
+    // Threads de calcul de update(), pour toutes les grilles ; 0 : un par cœur
+    static void setThreadCount(unsigned count);
+    static unsigned getThreadCount();
     void print() const;
     Cell* getCell(int x, int y) const;
     void setCell(int x, int y, Cell* cell);
@@ -24,21 +61,77 @@ public:
     void clearGrid();
     void setObstacle(int x, int y, bool isAlive);
 
+    // Export/import de l'état complet sous forme de codes (ligne par ligne)
+    std::vector<uint8_t> getStateCodes() const;
+    void setStateCodes(const std::vector<uint8_t>& codes);
+
+    uint8_t getCellCode(int x, int y) const;
+    void setCellCode(int x, int y, uint8_t code);
+
     void setToroidal(bool value);
     bool isToroidal() const;
 
+    // Règle B/S : bit n du masque = naissance (ou survie) avec n voisins
+    static const uint16_t ConwayBirth = 1 << 3;
+    static const uint16_t ConwaySurvival = (1 << 2) | (1 << 3);
+    void setRule(uint16_t birth, uint16_t survival);
+    uint16_t getBirthMask() const { return birthMask; }
+    uint16_t getSurvivalMask() const { return survivalMask; }
+    std::string getRuleString() const;  // Notation "B3/S23"
+    static bool parseRule(const std::string& text, uint16_t& birth, uint16_t& survival);
+
     bool operator==(const Grid& other) const;
 
+    // Statistiques calculées sur les plans de bits
+    int countAlive() const;
+    int countChangedTiles() const;  // Tuiles modifiées par la dernière génération
+    void countChanges(const Grid& previous, int& created, int& destroyed) const;
+
     int getWidth() const { return width; }
     int getHeight() const { return height; }
 
+    // Accès aux tuiles (historique, formats de fichiers, rendu)
+    int getTilesX() const { return tilesX; }
+    int getTilesY() const { return tilesY; }
+    int getTileCount() const { return tilesX * tilesY; }
+    const Tile& getTile(int index) const { return *tiles[index]; }
+    Tile& getMutableTile(int index);
+    bool sharesTile(const Grid& other, int index) const;
+    // Partage d'une tuile de contenu identique (déduplication) : ni la
+    // révision ni les tuiles actives ne changent
+    const std::shared_ptr<Tile>& getSharedTile(int index) const { return tiles[index]; }
+    void setSharedTile(int index, const std::shared_ptr<Tile>& tile);
+    // Remplace le contenu d'une tuile (chargement de fichiers sans recopie)
+    void replaceTile(int index, const std::shared_ptr<Tile>& tile);
+    // Tuile vide canonique, partagée par toutes les grilles
+    static const std::shared_ptr<Tile>& emptyTile();
+    // Force le recalcul de toutes les tuiles à la prochaine génération
+    void markAllActive();
+    int countSharedTiles(const Grid& other) const;
+
 private:
     int width;
     int height;
     bool toroidal;
-    std::vector<std::vector<Cell*>> cells;
+    uint16_t birthMask;
+    uint16_t survivalMask;
+    int tilesX;
+    int tilesY;
+    std::vector<std::shared_ptr<Tile>> tiles;
+    std::vector<uint8_t> activeTiles;  // Tuiles modifiées depuis la dernière génération
+    uint64_t revision;
 
-    int countAliveNeighbors(int x, int y) const;
+    static uint64_t nextRevision();
+
+    uint64_t countableRow(int tx, int gy) const;
+    uint64_t countableBit(int gx, int gy) const;
+    bool needsUpdate(int tx, int ty) const;
+    void advance(int* created, int* destroyed);
+    void computeTile(int tx, int ty, Tile& next) const;
 };
 
+inline void swap(Grid& a, Grid& b) noexcept {
+    a.swap(b);
+}
+
 }
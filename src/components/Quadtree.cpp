@@ -0,0 +1,221 @@
+// Quadtree.cpp
+#include "components/Quadtree.h"
+#include <algorithm>
+#include <cstring>
+
+namespace GameOfLife {
+
+namespace {
+
+uint64_t saturatingAdd(uint64_t a, uint64_t b) {
+    return a > UINT64_MAX - b ? UINT64_MAX : a + b;
+}
+
+int popcount(uint64_t value) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(value);
+#else
+    value = value - ((value >> 1) & 0x5555555555555555ULL);
+    value = (value & 0x3333333333333333ULL) + ((value >> 2) & 0x3333333333333333ULL);
+    value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<int>((value * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+}
+
+const int Quadtree::LeafLevel;
+const int Quadtree::MaxLevel;
+const uint32_t Quadtree::Empty;
+
+bool Quadtree::Key::operator==(const Key& other) const {
+    return level == other.level && bits == other.bits &&
+           std::memcmp(children, other.children, sizeof(children)) == 0;
+}
+
+size_t Quadtree::KeyHasher::operator()(const Key& key) const {
+    uint64_t h = key.bits * 0x9E3779B97F4A7C15ULL + static_cast<uint64_t>(key.level);
+    for (uint32_t child : key.children) {
+        h = (h ^ child) * 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 32;
+    }
+    return static_cast<size_t>(h);
+}
+
+Quadtree::Quadtree() {
+    clear();
+}
+
+void Quadtree::clear() {
+    nodes.assign(1, Node{-1, {Empty, Empty, Empty, Empty}, 0, 0});
+    index.clear();
+    root = Empty;
+    rootLevel = LeafLevel;
+}
+
+uint32_t Quadtree::intern(const Key& key, uint64_t population) {
+    auto found = index.find(key);
+    if (found != index.end()) {
+        return found->second;
+    }
+    uint32_t id = static_cast<uint32_t>(nodes.size());
+    nodes.push_back(Node{key.level, {key.children[0], key.children[1], key.children[2], key.children[3]},
+                         key.bits, population});
+    index.emplace(key, id);
+    return id;
+}
+
+uint32_t Quadtree::leaf(uint64_t bits) {
+    if (bits == 0) {
+        return Empty;
+    }
+    return intern(Key{LeafLevel, {Empty, Empty, Empty, Empty}, bits}, popcount(bits));
+}
+
+uint32_t Quadtree::node(int level, uint32_t nw, uint32_t ne, uint32_t sw, uint32_t se) {
+    if ((nw | ne | sw | se) == Empty) {
+        return Empty;
+    }
+    uint64_t population = 0;
+    for (uint32_t child : {nw, ne, sw, se}) {
+        population = saturatingAdd(population, nodes[child].population);
+    }
+    return intern(Key{level, {nw, ne, sw, se}, 0}, population);
+}
+
+int Quadtree::levelOf(uint32_t id) const {
+    return nodes[id].level;
+}
+
+uint64_t Quadtree::leafBits(uint32_t id) const {
+    return nodes[id].bits;
+}
+
+const uint32_t* Quadtree::childrenOf(uint32_t id) const {
+    return nodes[id].children;
+}
+
+uint64_t Quadtree::populationOf(uint32_t id) const {
+    return nodes[id].population;
+}
+
+size_t Quadtree::nodeCount() const {
+    return nodes.size() - 1;
+}
+
+void Quadtree::setRoot(uint32_t id, int level) {
+    root = id;
+    rootLevel = level;
+}
+
+void Quadtree::build(const Grid& grid) {
+    clear();
+    int side = std::max(grid.getWidth(), grid.getHeight());
+    int level = LeafLevel;
+    while ((1LL << level) < side) {
+        ++level;
+    }
+
+    // Feuilles : blocs de 8 x 8 extraits des mots de 64 bits des tuiles
+    const int blocksPerTile = Grid::TileSize / 8;
+    int blocksX = (grid.getWidth() + 7) / 8;
+    int blocksY = (grid.getHeight() + 7) / 8;
+    std::vector<uint32_t> ids(static_cast<size_t>(blocksX) * blocksY, Empty);
+    for (int t = 0; t < grid.getTileCount(); ++t) {
+        if (grid.getSharedTile(t) == Grid::emptyTile()) {
+            continue;
+        }
+        const Grid::Tile& tile = grid.getTile(t);
+        int tx = t % grid.getTilesX();
+        int ty = t / grid.getTilesX();
+        for (int by = 0; by < blocksPerTile && ty * blocksPerTile + by < blocksY; ++by) {
+            for (int bx = 0; bx < blocksPerTile && tx * blocksPerTile + bx < blocksX; ++bx) {
+                uint64_t bits = 0;
+                for (int r = 0; r < 8; ++r) {
+                    bits |= ((tile.alive[by * 8 + r] >> (bx * 8)) & 0xFF) << (8 * r);
+                }
+                ids[static_cast<size_t>(ty * blocksPerTile + by) * blocksX + tx * blocksPerTile + bx] = leaf(bits);
+            }
+        }
+    }
+
+    // Regroupement par carrés de 2 x 2 jusqu'à la racine
+    for (int l = LeafLevel + 1; l <= level; ++l) {
+        int nextX = (blocksX + 1) / 2;
+        int nextY = (blocksY + 1) / 2;
+        std::vector<uint32_t> next(static_cast<size_t>(nextX) * nextY, Empty);
+        auto at = [&](int x, int y) {
+            return x < blocksX && y < blocksY ? ids[static_cast<size_t>(y) * blocksX + x] : Empty;
+        };
+        for (int y = 0; y < nextY; ++y) {
+            for (int x = 0; x < nextX; ++x) {
+                next[static_cast<size_t>(y) * nextX + x] =
+                    node(l, at(2 * x, 2 * y), at(2 * x + 1, 2 * y), at(2 * x, 2 * y + 1), at(2 * x + 1, 2 * y + 1));
+            }
+        }
+        ids.swap(next);
+        blocksX = nextX;
+        blocksY = nextY;
+    }
+
+    setRoot(ids.empty() ? Empty : ids[0], level);
+}
+
+void Quadtree::flatten(Grid& grid, int64_t x, int64_t y) const {
+    grid.clearGrid();
+    flattenNode(root, rootLevel, 0, 0, grid, x, y);
+}
+
+void Quadtree::flattenNode(uint32_t id, int level, int64_t nx, int64_t ny,
+                           Grid& grid, int64_t x, int64_t y) const {
+    if (id == Empty) {
+        return;
+    }
+    const int64_t size = 1LL << level;
+    if (nx >= x + grid.getWidth() || ny >= y + grid.getHeight() || nx + size <= x || ny + size <= y) {
+        return;
+    }
+
+    if (level > LeafLevel) {
+        const int64_t half = size / 2;
+        const uint32_t* children = nodes[id].children;
+        flattenNode(children[0], level - 1, nx, ny, grid, x, y);
+        flattenNode(children[1], level - 1, nx + half, ny, grid, x, y);
+        flattenNode(children[2], level - 1, nx, ny + half, grid, x, y);
+        flattenNode(children[3], level - 1, nx + half, ny + half, grid, x, y);
+        return;
+    }
+
+    // Feuille : chaque ligne de 8 bits est placée dans une ou deux tuiles
+    const uint64_t bits = nodes[id].bits;
+    for (int r = 0; r < 8; ++r) {
+        int64_t gy = ny + r - y;
+        uint64_t row = (bits >> (8 * r)) & 0xFF;
+        if (gy < 0 || gy >= grid.getHeight() || row == 0) {
+            continue;
+        }
+        int64_t gx = nx - x;
+        if (gx < 0) {
+            row >>= -gx;
+            gx = 0;
+        }
+        int tileRow = static_cast<int>(gy % Grid::TileSize);
+        int tileY = static_cast<int>(gy / Grid::TileSize);
+        while (row != 0 && gx < grid.getWidth()) {
+            int tx = static_cast<int>(gx / Grid::TileSize);
+            int offset = static_cast<int>(gx % Grid::TileSize);
+            int validWidth = std::min(Grid::TileSize, grid.getWidth() - tx * Grid::TileSize);
+            uint64_t valid = validWidth == Grid::TileSize ? ~0ULL : ((1ULL << validWidth) - 1);
+            uint64_t part = (row << offset) & valid;
+            if (part != 0) {
+                grid.getMutableTile(tileY * grid.getTilesX() + tx).alive[tileRow] |= part;
+            }
+            // Bits débordant sur la tuile suivante
+            int used = Grid::TileSize - offset;
+            row = used >= 8 ? 0 : row >> used;
+            gx += used;
+        }
+    }
+}
+
+}
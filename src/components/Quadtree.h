@@ -0,0 +1,78 @@
+// Quadtree.h
+#pragma once
+#include "components/Grid.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace GameOfLife {
+
+// Arbre quaternaire à partage de structure (hash-consing) : deux sous-carrés
+// identiques sont un seul nœud, ce qui représente des motifs gigantesques mais
+// réguliers en mémoire proportionnelle à leur taille compressée.
+// Les feuilles sont des carrés de 8 x 8 cellules (niveau 3, bit y * 8 + x) ;
+// un nœud de niveau k couvre 2^k x 2^k cellules. L'identifiant 0 désigne un
+// carré vide, quel que soit son niveau.
+class Quadtree {
+public:
+    static const int LeafLevel = 3;
+    static const int MaxLevel = 62;
+    static const uint32_t Empty = 0;
+
+    Quadtree();
+
+    void clear();
+
+    // Nœuds canoniques (un nœud identique existant est réutilisé)
+    uint32_t leaf(uint64_t bits);
+    uint32_t node(int level, uint32_t nw, uint32_t ne, uint32_t sw, uint32_t se);
+
+    int levelOf(uint32_t id) const;
+    uint64_t leafBits(uint32_t id) const;
+    const uint32_t* childrenOf(uint32_t id) const;  // nw, ne, sw, se
+    uint64_t populationOf(uint32_t id) const;       // Saturée à UINT64_MAX
+    size_t nodeCount() const;                       // Nœuds distincts non vides
+
+    // Racine du motif et son niveau (coin supérieur gauche en 0, 0)
+    uint32_t getRoot() const { return root; }
+    int getRootLevel() const { return rootLevel; }
+    void setRoot(uint32_t id, int level);
+
+    // Construit l'arbre des cellules vivantes de grid
+    void build(const Grid& grid);
+
+    // Copie dans grid la région du motif dont le coin supérieur gauche est
+    // (x, y) ; seules les branches non vides qui la recoupent sont parcourues
+    void flatten(Grid& grid, int64_t x, int64_t y) const;
+
+private:
+    struct Node {
+        int level;
+        uint32_t children[4];
+        uint64_t bits;
+        uint64_t population;
+    };
+
+    struct Key {
+        int level;
+        uint32_t children[4];
+        uint64_t bits;
+
+        bool operator==(const Key& other) const;
+    };
+
+    struct KeyHasher {
+        size_t operator()(const Key& key) const;
+    };
+
+    std::vector<Node> nodes;                        // nodes[0] : carré vide
+    std::unordered_map<Key, uint32_t, KeyHasher> index;
+    uint32_t root;
+    int rootLevel;
+
+    uint32_t intern(const Key& key, uint64_t population);
+    void flattenNode(uint32_t id, int level, int64_t nx, int64_t ny,
+                     Grid& grid, int64_t x, int64_t y) const;
+};
+
+}
@@ -1,44 +1,137 @@
 // console.cpp
 #include "console.h"
 
+#include <algorithm>
 #include <iostream>
-#include <fstream>
-#include <filesystem>
 #include <vector>
 #include <thread>
 #include <chrono>
 
 // Inclure les composants nécessaires du jeu
 #include "services/Game.h"
+#include "services/SaveIndex.h"
+#include "services/TerminalInput.h"
+#include "services/TerminalRenderer.h"
 #include "components/Grid.h"
-#include "components/Cell.h"
-#include "components/DeadObstacleCell.h"
 
-namespace fs = std::filesystem;
 using namespace GameOfLife;
 
-void runConsoleMode() {
-    std::cout << "Mode Console sélectionné." << std::endl;
+namespace {
 
-    // Lister les fichiers dans le dossier "saves/"
-    std::string saveDirectory = "saves/";
-    std::vector<std::string> saveFiles;
+// Paliers de vitesse des touches < et >, en générations par seconde ;
+// au-delà du dernier, la vitesse est illimitée (0)
+const int SpeedLevels[] = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000};
 
-    for (const auto& entry : fs::directory_iterator(saveDirectory)) {
-        if (entry.path().extension() == ".txt") {
-            saveFiles.push_back(entry.path().filename().string());
+int changeSpeed(int speed, int offset) {
+    const int count = sizeof(SpeedLevels) / sizeof(SpeedLevels[0]);
+    if (offset > 0) {
+        for (int level : SpeedLevels) {
+            if (speed != 0 && level > speed) {
+                return level;
+            }
+        }
+        return 0;
+    }
+    if (speed == 0) {
+        return SpeedLevels[count - 1];
+    }
+    for (int i = count - 1; i >= 0; --i) {
+        if (SpeedLevels[i] < speed) {
+            return SpeedLevels[i];
         }
     }
+    return SpeedLevels[0];
+}
+
+// Commandes de l'affichage pendant la simulation ; faux pour quitter
+bool handleKey(int key, TerminalRenderer& renderer, Game& game, int& speed) {
+    const Grid& grid = game.getGrid();
+    int64_t stepX = std::max<int64_t>(1, renderer.getViewportWidth() / 4);
+    int64_t stepY = std::max<int64_t>(1, renderer.getViewportHeight() / 4);
+    int64_t centerX = renderer.getViewportX() + renderer.getViewportWidth() / 2;
+    int64_t centerY = renderer.getViewportY() + renderer.getViewportHeight() / 2;
+    switch (key) {
+        case 'q':
+            return false;
+        case 'm':
+            // Cellules, demi-blocs puis braille
+            renderer.setMode(static_cast<TerminalRenderer::Mode>((renderer.getMode() + 1) % 3));
+            break;
+        case 'f':
+            renderer.fitViewport(grid);
+            break;
+        case '+':
+        case '-':
+            // Zoom autour du centre de la fenêtre
+            renderer.setZoom(key == '+' ? renderer.getZoom() / 2 : renderer.getZoom() * 2);
+            renderer.setViewport(centerX - renderer.getViewportWidth() / 2, centerY - renderer.getViewportHeight() / 2);
+            break;
+        case TerminalInput::ArrowLeft:
+            renderer.setViewport(renderer.getViewportX() - stepX, renderer.getViewportY());
+            break;
+        case TerminalInput::ArrowRight:
+            renderer.setViewport(renderer.getViewportX() + stepX, renderer.getViewportY());
+            break;
+        case TerminalInput::ArrowUp:
+            renderer.setViewport(renderer.getViewportX(), renderer.getViewportY() - stepY);
+            break;
+        case TerminalInput::ArrowDown:
+            renderer.setViewport(renderer.getViewportX(), renderer.getViewportY() + stepY);
+            break;
+        case '<':
+        case '>':
+            speed = changeSpeed(speed, key == '>' ? 1 : -1);
+            break;
+        case 'j':
+        case 'l':
+        case 'i':
+        case 'k':
+            // Autre zone d'un motif .mc, décalée d'une demi-grille (la simulation y reprend)
+            if (game.hasPattern()) {
+                int64_t dx = key == 'j' ? -grid.getWidth() / 2 : key == 'l' ? grid.getWidth() / 2 : 0;
+                int64_t dy = key == 'i' ? -grid.getHeight() / 2 : key == 'k' ? grid.getHeight() / 2 : 0;
+                game.setPatternViewport(game.getPatternViewportX() + dx, game.getPatternViewportY() + dy);
+            }
+            break;
+        default:
+            break;
+    }
+    return true;
+}
+
+std::string statusLine(const Game& game, const TerminalRenderer& renderer, int population, int speed) {
+    std::string status = "Itération : " + std::to_string(game.getIterations());
+    status += speed > 0 ? " | " + std::to_string(speed) + " gén./s" : std::string(" | vitesse illimitée");
+    if (population >= 0) {
+        status += " | population : " + std::to_string(population);
+    }
+    if (renderer.getMode() != TerminalRenderer::Cells) {
+        status += " | zoom 1:" + std::to_string(renderer.getZoom()) + " | (" + std::to_string(renderer.getViewportX()) +
+                  ", " + std::to_string(renderer.getViewportY()) + ")";
+    }
+    if (game.hasPattern()) {
+        status += " | motif (" + std::to_string(game.getPatternViewportX()) + ", " +
+                  std::to_string(game.getPatternViewportY()) + ") : i/j/k/l";
+    }
+    return status + " | flèches, +/-, f, m : affichage ; < > : vitesse ; q : quitter";
+}
+
+// Choix d'une sauvegarde du dossier "saves/" ; faux si rien n'a été chargé
+bool chooseSave(Game& game) {
+    std::string saveDirectory = "saves/";
+    SaveIndex saveIndex(saveDirectory);
+    saveIndex.refresh();
+    const std::vector<SaveIndex::Entry>& saveFiles = saveIndex.getEntries();
 
     if (saveFiles.empty()) {
         std::cout << "Aucun fichier de sauvegarde trouvé dans le dossier 'saves/'." << std::endl;
-        return;
+        return false;
     }
 
     // Afficher les fichiers disponibles
     std::cout << "Fichiers disponibles : " << std::endl;
     for (size_t i = 0; i < saveFiles.size(); ++i) {
-        std::cout << i + 1 << ". " << saveFiles[i] << std::endl;
+        std::cout << i + 1 << ". " << saveFiles[i].name << " (" << SaveIndex::describe(saveFiles[i]) << ")" << std::endl;
     }
 
     // Demander à l'utilisateur de sélectionner un fichier
@@ -48,78 +141,124 @@ void runConsoleMode() {
 
     if (choice < 1 || choice > static_cast<int>(saveFiles.size())) {
         std::cout << "Choix invalide. Retour au menu principal." << std::endl;
-        return;
+        return false;
     }
+    return game.loadFromFile(saveFiles[choice - 1].name);
+}
 
-    // Charger le fichier sélectionné
-    std::string selectedFile = saveDirectory + saveFiles[choice - 1];
-    std::ifstream inputFile(selectedFile);
+}
+
+int runConsoleMode(const ConsoleOptions& options) {
+    std::cout << "Mode Console sélectionné." << std::endl;
 
-    if (!inputFile.is_open()) {
-        std::cerr << "Erreur : Impossible d'ouvrir le fichier " << selectedFile << std::endl;
-        return;
+    // Charger la sauvegarde : même lecture et même moteur que le mode graphique.
+    // Les motifs (.rle, .mc) sont placés dans une grille de la taille par défaut,
+    // les sauvegardes complètes imposent leurs dimensions.
+    int maxIterations = options.generations;
+    Game game(80, 80, maxIterations);
+    // Pas d'undo en console : aucune génération n'est enregistrée
+    game.setHistoryEnabled(false);
+    if (options.input.empty() ? !chooseSave(game) : !game.loadFromPath(options.input)) {
+        if (!options.input.empty()) {
+            std::cerr << "Erreur : impossible de charger " << options.input << std::endl;
+        }
+        return 1;
+    }
+    if (!options.rule.empty()) {
+        uint16_t birth, survival;
+        if (!Grid::parseRule(options.rule, birth, survival)) {
+            std::cerr << "Erreur : règle invalide " << options.rule << std::endl;
+            return 1;
+        }
+        game.getGrid().setRule(birth, survival);
     }
 
-    // Lire la grille depuis le fichier
-    std::vector<std::string> grid;
-    std::string line;
-    while (std::getline(inputFile, line)) {
-        grid.push_back(line);
+    if (!options.metrics.empty() && !game.startMetrics(options.metrics, options.metricsInterval)) {
+        return 1;
     }
-    inputFile.close();
 
-    int width = grid[0].size();
-    int height = grid.size();
+    std::cout << "Simulation démarrée en mode console. Appuyez sur q pour arrêter." << std::endl;
+
+    // Vitesse de la simulation indépendante de l'affichage : celui-ci, limité
+    // à la fréquence du terminal, saute des images et ne réécrit que les
+    // cellules changées. En attendant la génération suivante, les touches
+    // restent lues au rythme de l'affichage.
+    const auto inputPeriod = std::chrono::milliseconds(15);
+    int speed = std::max(0, options.speed);
+    auto nextGeneration = std::chrono::steady_clock::now();
+    TerminalRenderer renderer;
+    TerminalInput input;
+    bool stable = false;
+    bool quit = false;
+    int population = -1;
 
-    std::cout << "Simulation démarrée en mode console. Appuyez sur Ctrl+C pour arrêter." << std::endl;
+    // Une grille plus grande que le terminal est montrée réduite, en braille
+    if (!renderer.fitsOnScreen(game.getGrid())) {
+        renderer.setMode(TerminalRenderer::Braille);
+        renderer.fitViewport(game.getGrid());
+    }
 
-    // Fonction pour calculer les voisins vivants
-    auto countAliveNeighbors = [&](int x, int y) {
-        int aliveCount = 0;
-        for (int dy = -1; dy <= 1; ++dy) {
-            for (int dx = -1; dx <= 1; ++dx) {
-                if (dx == 0 && dy == 0) continue; // Ignorer la cellule elle-même
-                int nx = x + dx;
-                int ny = y + dy;
-                if (nx >= 0 && nx < width && ny >= 0 && ny < height) {
-                    aliveCount += (grid[ny][nx] == '1');
-                }
+    // Simuler les itérations ; un enregistrement .golr est relu jusqu'au bout
+    bool advanced = true;
+    for (int iteration = 0; ; ) {
+        bool replaying = game.isReplaying();
+        for (int key = input.poll(); key >= 0 && !quit; key = input.poll()) {
+            int previousSpeed = speed;
+            quit = !handleKey(key, renderer, game, speed);
+            if (speed != previousSpeed) {
+                nextGeneration = std::chrono::steady_clock::now();
             }
         }
-        return aliveCount;
-    };
-
-    // Simuler les itérations
-    int maxIterations = 100;
-    for (int iteration = 0; iteration < maxIterations; ++iteration) {
-        // Afficher la grille actuelle
-        std::cout << "Itération : " << iteration + 1 << std::endl;
-        for (const auto& row : grid) {
-            std::cout << row << std::endl;
+        quit = quit || input.isInterrupted();
+        bool last = quit || stable || (replaying ? game.getReplayPosition() + 1 >= game.getReplayLength() : iteration >= maxIterations);
+        if (options.statsInterval > 0 && ((advanced && iteration % options.statsInterval == 0) || last)) {
+            population = game.getGrid().countAlive();
         }
-        std::cout << std::string(width, '-') << std::endl;
-
-        // Calculer la prochaine grille
-        std::vector<std::string> newGrid = grid;
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; ++x) {
-                int aliveNeighbors = countAliveNeighbors(x, y);
-                if (grid[y][x] == '1') {
-                    // Règle : Une cellule vivante reste vivante si elle a 2 ou 3 voisins vivants
-                    newGrid[y][x] = (aliveNeighbors == 2 || aliveNeighbors == 3) ? '1' : '0';
-                } else {
-                    // Règle : Une cellule morte devient vivante si elle a exactement 3 voisins vivants
-                    newGrid[y][x] = (aliveNeighbors == 3) ? '1' : '0';
-                }
-            }
+
+        // La dernière image est toujours affichée
+        renderer.render(game.getGrid(), statusLine(game, renderer, population, speed), last);
+        if (last) {
+            break;
         }
 
-        // Mettre à jour la grille
-        grid = newGrid;
+        auto now = std::chrono::steady_clock::now();
+        if (speed > 0 && now < nextGeneration) {
+            std::this_thread::sleep_until(std::min(nextGeneration, now + inputPeriod));
+            advanced = false;
+            continue;
+        }
+
+        game.setPreviousGrid(game.getGrid());
+        game.step();
+        stable = !replaying && game.isStable();
+        ++iteration;
+        advanced = true;
 
-        // Pause pour mieux visualiser les itérations
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        if (speed > 0) {
+            // Un retard n'est pas rattrapé par une rafale de générations
+            nextGeneration = std::max(nextGeneration + std::chrono::nanoseconds(1000000000 / speed), now);
+        }
     }
+    renderer.finish();
 
+    game.stopMetrics();
+    if (stable) {
+        std::cout << "État stable atteint." << std::endl;
+    }
     std::cout << "Simulation terminée." << std::endl;
+
+    if (!options.output.empty() && !game.saveToPath(options.output)) {
+        std::cerr << "Erreur : impossible d'écrire " << options.output << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int runBatchMode(const BatchRun::Options& options) {
+    BatchRun::Summary summary;
+    if (!BatchRun::run(options, summary)) {
+        return 1;
+    }
+    BatchRun::printSummary(summary, std::cout);
+    return 0;
 }
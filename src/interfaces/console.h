@@ -2,6 +2,25 @@
 #ifndef CONSOLE_H
 #define CONSOLE_H
 
-void runConsoleMode();
+#include "services/BatchRun.h"
+#include <string>
+
+// Lancement depuis la ligne de commande ; sans fichier d'entrée, la
+// sauvegarde est choisie dans un menu
+struct ConsoleOptions {
+    std::string input;        // Chemin de la sauvegarde, pris tel quel
+    std::string output;       // État final, format selon l'extension ; vide : pas d'écriture
+    std::string rule;         // Règle imposée ("B3/S23") ; vide : celle de la sauvegarde
+    int generations = 100;
+    int speed = 100;          // Générations par seconde ; 0 : illimitée (l'affichage reste limité)
+    int statsInterval = 0;    // Population affichée toutes les n générations ; 0 : jamais
+    std::string metrics;      // Statistiques par génération (.csv ou .jsonl) ; vide : aucune
+    uint64_t metricsInterval = 1;
+};
+
+int runConsoleMode(const ConsoleOptions& options = ConsoleOptions());  // 0 : succès
+
+// Simulation sans affichage : seul le résumé est écrit sur la sortie standard
+int runBatchMode(const GameOfLife::BatchRun::Options& options);
 
 #endif // CONSOLE_H
@@ -7,10 +7,17 @@
 #include <vector>
 #include <thread>
 #include <chrono>
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <unordered_map>
 #include <SFML/Graphics.hpp>
 
 // Inclure les composants nécessaires du jeu
+#include "services/BoardImage.h"
 #include "services/Game.h"
+#include "services/SaveIndex.h"
+#include "services/ThumbnailCache.h"
 #include "components/Grid.h"
 #include "components/Cell.h"
 #include "components/patterns.h"
@@ -23,6 +30,17 @@ using namespace GameOfLife;
 const int cellSize = 10;
 const int sidebarWidth = 200; // Largeur de la barre latérale pour le score
 
+namespace {
+
+// Taille en mégaoctets, à une décimale
+std::string megabytes(size_t bytes) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.1f Mo", bytes / (1024.0 * 1024.0));
+    return text;
+}
+
+}
+
 void runGraphicalMode() {
     // Paramètres de la fenêtre
     int width = 80;
@@ -234,19 +252,34 @@ void runGraphicalMode() {
     bool isHelpVisible = false;
 
     // Fenêtre d'aide
-    sf::RectangleShape helpBackground(sf::Vector2f(500, 450));
+    sf::RectangleShape helpBackground(sf::Vector2f(500, 550));
     helpBackground.setFillColor(sf::Color(240, 240, 240)); // Couleur claire
     helpBackground.setOutlineColor(sf::Color::Black);
     helpBackground.setOutlineThickness(2);
     helpBackground.setPosition((windowWidth - helpBackground.getSize().x) / 2, (height * cellSize - helpBackground.getSize().y) / 2);
 
-    // Pré-créer la forme de cellule
-    sf::RectangleShape cellShape(sf::Vector2f(cellSize - 1.0f, cellSize - 1.0f));
+    // Plateau : une texture d'un pixel par cellule, agrandie sans lissage, et
+    // le quadrillage en un seul tableau de lignes
+    BoardImage boardImage;
+    sf::Texture boardTexture;
+    sf::Sprite boardSprite;
+    sf::VertexArray gridLines(sf::Lines);
+    float boardScale = cellSize;  // Pixels par cellule à l'écran
 
     // Variables pour contrôler le temps
     sf::Clock clock;
     float timeSinceLastUpdate = 0.0f;
-    const float timePerFrame = 1.0f / 10.0f; // 10 mises à jour par seconde
+
+    // Vitesse de la simulation, indépendante de l'affichage (60 images/s) :
+    // flèches gauche/droite pour changer de palier, 0 pour « illimitée »
+    // (calcul en continu, l'affichage montrant la dernière génération)
+    const int speedLevels[] = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 0};
+    const int speedLevelCount = sizeof(speedLevels) / sizeof(speedLevels[0]);
+    int speedLevel = 3; // 10 générations par seconde
+    const float stepBudget = 0.012f; // Temps de calcul maximal par image, en secondes
+    sf::Clock rateClock;             // Mesure des générations effectivement calculées par seconde
+    int generationsSinceRate = 0;
+    float measuredRate = 0.0f;
 
     // Variables pour le score
     int livingCells = 0;
@@ -280,9 +313,103 @@ void runGraphicalMode() {
     sidebar.setFillColor(sf::Color(50, 50, 50)); // Gris foncé
     sidebar.setPosition(width * cellSize, 0);
 
+    // Barre de défilement de l'historique (accès direct à une génération)
+    sf::RectangleShape scrubberTrack(sf::Vector2f(sidebarWidth - 20, 8));
+    scrubberTrack.setFillColor(sf::Color(120, 120, 120));
+    scrubberTrack.setPosition(width * cellSize + 10, 176);
+
+    sf::RectangleShape scrubberHandle(sf::Vector2f(8, 20));
+    scrubberHandle.setFillColor(sf::Color::White);
+
+    sf::Text scrubberText;
+    scrubberText.setFont(font);
+    scrubberText.setCharacterSize(14);
+    scrubberText.setFillColor(sf::Color::White);
+    scrubberText.setPosition(width * cellSize + 10, 145);
+
+    // Branche courante de l'historique (alternatives explorées après un undo)
+    sf::Text branchText;
+    branchText.setFont(font);
+    branchText.setCharacterSize(14);
+    branchText.setFillColor(sf::Color::White);
+    branchText.setPosition(width * cellSize + 10, 192);
+
+    // État de la dernière sauvegarde (écrite en arrière-plan)
+    sf::Text saveStatusText;
+    saveStatusText.setFont(font);
+    saveStatusText.setCharacterSize(14);
+    saveStatusText.setFillColor(sf::Color::White);
+    saveStatusText.setPosition(width * cellSize + 10, 216);
+
+    // Enregistrement ou relecture en cours (.golr)
+    sf::Text recordingText;
+    recordingText.setFont(font);
+    recordingText.setCharacterSize(14);
+    recordingText.setFillColor(sf::Color::White);
+    recordingText.setPosition(width * cellSize + 10, 240);
+
+    sf::Text speedText;
+    speedText.setFont(font);
+    speedText.setCharacterSize(14);
+    speedText.setFillColor(sf::Color::White);
+    speedText.setPosition(width * cellSize + 10, 264);
+
+    // Mémoire et disque de l'historique : occupés, puis sans partage des tuiles identiques
+    sf::Text historyText;
+    historyText.setFont(font);
+    historyText.setCharacterSize(14);
+    historyText.setFillColor(sf::Color::White);
+    historyText.setPosition(width * cellSize + 10, 288);
+
+    bool isScrubbing = false;
+
+    // Calculer une génération et mettre à jour les compteurs
+    auto advanceGeneration = [&]() {
+        // Cellules créées et détruites comptées pendant le calcul, sans copie de la grille précédente
+        int cellsCreatedInThisUpdate = 0;
+        int cellsDestroyedInThisUpdate = 0;
+        game.step(cellsCreatedInThisUpdate, cellsDestroyedInThisUpdate);  // Enregistre l'état actuel pour l'undo puis avance d'une génération
+        ++generationsSinceRate;
+
+        // Mettre à jour les compteurs
+        cellsCreated += cellsCreatedInThisUpdate;
+        cellsDestroyed += cellsDestroyedInThisUpdate;
+
+        if (game.isStable()) {
+            game.state = Game::Finished;
+        } else {
+            game.setPreviousGrid(game.getGrid());
+        }
+
+        if (game.getIterations() >= static_cast<uint64_t>(std::max(0, game.getMaxIterations()))) {
+            game.state = Game::Finished;
+        }
+    };
+
+    // Sauter à la génération correspondant à l'abscisse de la souris
+    auto scrubTo = [&](int mouseX) {
+        size_t first = game.getTimelineBegin();
+        size_t last = game.getTimelineEnd() - 1;
+        float ratio = (mouseX - scrubberTrack.getPosition().x) / scrubberTrack.getSize().x;
+        ratio = std::max(0.0f, std::min(1.0f, ratio));
+
+        if (game.state == Game::Simulation) {
+            game.state = Game::Paused;
+        }
+        game.seek(first + static_cast<size_t>(ratio * (last - first) + 0.5f));
+        game.setPreviousGrid(game.getGrid());
+    };
+
     sf::Event event; // Déclaration de l'événement ici pour être accessible partout
     sf::String userInput; // Variable pour stocker l'entrée de l'utilisateur
-    std::vector<std::string> saveFiles;  // Liste des fichiers de sauvegarde
+    SaveIndex saveIndex("saves/");        // Métadonnées des sauvegardes, mises à jour par date
+    std::vector<SaveIndex::Entry> saveFiles;  // Liste des fichiers de sauvegarde
+
+    // Miniatures calculées en arrière-plan, affichées page par page dès qu'elles sont prêtes
+    ThumbnailCache thumbnails("saves/");
+    std::unordered_map<uint64_t, sf::Texture> thumbnailTextures;
+    const size_t filesPerPage = static_cast<size_t>((windowHeight - 160) / 50);
+    size_t loadPage = 0;
     bool isTyping = false; // Indique si l'utilisateur est en train de saisir un nom de fichier
 
     // Boucle principale du jeu
@@ -325,15 +452,11 @@ void runGraphicalMode() {
                         mouseY >= menuLoadButton.getPosition().y &&
                         mouseY <= menuLoadButton.getPosition().y + menuLoadButton.getSize().y) {
 
-                        // Lister les fichiers de sauvegarde disponibles
-                        saveFiles.clear();  // Nettoyer avant de rajouter les fichiers disponibles
-                        std::string saveDirectory = "saves/";
-
-                        for (const auto& entry : fs::directory_iterator(saveDirectory)) {
-                            if (entry.path().extension() == ".txt") {
-                                saveFiles.push_back(entry.path().filename().string());
-                            }
-                        }
+                        // Lister les fichiers de sauvegarde disponibles (seuls les fichiers
+                        // modifiés depuis la dernière visite sont relus)
+                        saveIndex.refresh();
+                        saveFiles = saveIndex.getEntries();
+                        loadPage = 0;
 
                         if (!saveFiles.empty()) {
                             game.state = Game::LoadMenu; // Passer à l'état de menu de chargement
@@ -351,14 +474,49 @@ void runGraphicalMode() {
             window.clear();
             window.draw(background);  // Dessiner l'image de fond
 
-            // Afficher les fichiers de sauvegarde disponibles
+            // Afficher les fichiers de sauvegarde de la page courante
             float yOffset = 100;  // Position Y initiale pour l'affichage
             std::vector<sf::Text> fileTexts; // Pour stocker les textes des fichiers de sauvegarde
+            size_t pageCount = (saveFiles.size() + filesPerPage - 1) / filesPerPage;
+            size_t firstFile = loadPage * filesPerPage;
+            size_t lastFile = std::min(saveFiles.size(), firstFile + filesPerPage);
+
+            for (size_t i = firstFile; i < lastFile; ++i) {
+                // Miniature : demandée au premier affichage, dessinée dès qu'elle est prête
+                auto texture = thumbnailTextures.find(saveFiles[i].hash);
+                if (texture == thumbnailTextures.end()) {
+                    std::shared_ptr<const ThumbnailCache::Image> image = thumbnails.find(saveFiles[i]);
+                    if (image) {
+                        std::vector<sf::Uint8> rgba(image->pixels.size() * 4);
+                        for (size_t p = 0; p < image->pixels.size(); ++p) {
+                            sf::Uint8 level = static_cast<sf::Uint8>(255 - image->pixels[p]);
+                            rgba[4 * p] = rgba[4 * p + 1] = rgba[4 * p + 2] = level;
+                            rgba[4 * p + 3] = 255;
+                        }
+                        sf::Image pixels;
+                        pixels.create(image->width, image->height, rgba.data());
+                        texture = thumbnailTextures.emplace(saveFiles[i].hash, sf::Texture()).first;
+                        texture->second.loadFromImage(pixels);
+                    }
+                }
+                sf::RectangleShape thumbnailFrame(sf::Vector2f(40, 40));
+                thumbnailFrame.setPosition(40, yOffset);
+                thumbnailFrame.setFillColor(sf::Color(200, 200, 200));
+                thumbnailFrame.setOutlineColor(sf::Color::Black);
+                thumbnailFrame.setOutlineThickness(1);
+                window.draw(thumbnailFrame);
+                if (texture != thumbnailTextures.end()) {
+                    sf::Sprite thumbnail(texture->second);
+                    sf::Vector2u textureSize = texture->second.getSize();
+                    float scale = 40.0f / std::max(textureSize.x, textureSize.y);
+                    thumbnail.setScale(scale, scale);
+                    thumbnail.setPosition(40, yOffset);
+                    window.draw(thumbnail);
+                }
 
-            for (size_t i = 0; i < saveFiles.size(); ++i) {
                 sf::Text fileText;
                 fileText.setFont(font);
-                fileText.setString(saveFiles[i]);
+                fileText.setString(saveFiles[i].name);
                 fileText.setCharacterSize(30);
                 fileText.setFillColor(sf::Color::Black);
                 fileText.setPosition(100, yOffset);
@@ -366,9 +524,29 @@ void runGraphicalMode() {
                 fileTexts.push_back(fileText);
                 window.draw(fileText);
 
+                // Dimensions, population, règle et génération lues dans l'index
+                sf::Text detailText;
+                detailText.setFont(font);
+                detailText.setString(SaveIndex::describe(saveFiles[i]));
+                detailText.setCharacterSize(16);
+                detailText.setFillColor(sf::Color(60, 60, 60));
+                detailText.setPosition(fileText.getGlobalBounds().left + fileText.getGlobalBounds().width + 20, yOffset + 12);
+                window.draw(detailText);
+
                 yOffset += 50; // Espacement vertical entre chaque fichier
             }
 
+            if (pageCount > 1) {
+                sf::Text pageText;
+                pageText.setFont(font);
+                pageText.setString("Page " + std::to_string(loadPage + 1) + " / " + std::to_string(pageCount) +
+                                   "  (flèches gauche / droite)");
+                pageText.setCharacterSize(18);
+                pageText.setFillColor(sf::Color::Black);
+                pageText.setPosition(100, windowHeight - 50);
+                window.draw(pageText);
+            }
+
             window.display();
 
             // Gérer les événements pour la sélection du fichier à charger
@@ -386,8 +564,10 @@ void runGraphicalMode() {
                         sf::FloatRect bounds = fileTexts[i].getGlobalBounds();
                         if (bounds.contains(mouseX, mouseY)) {
                             // Charger le fichier sélectionné
-                            std::string filePath = "saves/" + saveFiles[i];
+                            std::string filePath = "saves/" + saveFiles[firstFile + i].name;
                             game.loadFromFile(filePath);
+                            isToroidal = game.getGrid().isToroidal();
+                            toroidalCheckbox.setFillColor(isToroidal ? sf::Color::Green : sf::Color::White);
                             game.state = Game::Edition; // Passer à l'état Edition après le chargement
                             break;
                         }
@@ -398,6 +578,16 @@ void runGraphicalMode() {
                     // Retourner à l'écran d'accueil si l'utilisateur appuie sur la touche échappement
                     game.state = Game::Accueil;
                 }
+
+                // Changement de page : les miniatures de l'ancienne page ne sont plus prioritaires
+                if (event.type == sf::Event::KeyPressed && pageCount > 1) {
+                    bool next = event.key.code == sf::Keyboard::Right || event.key.code == sf::Keyboard::PageDown;
+                    bool previous = event.key.code == sf::Keyboard::Left || event.key.code == sf::Keyboard::PageUp;
+                    if ((next && loadPage + 1 < pageCount) || (previous && loadPage > 0)) {
+                        loadPage = next ? loadPage + 1 : loadPage - 1;
+                        thumbnails.cancelPending();
+                    }
+                }
             }
             continue; // Revenir au début de la boucle tant que l'état est "LoadMenu"
         }
@@ -413,12 +603,57 @@ void runGraphicalMode() {
 
             // Gestion des touches
             if (event.type == sf::Event::KeyPressed) {
+                // Changer de branche de l'historique
+                if (!isTyping && (event.key.code == sf::Keyboard::PageUp || event.key.code == sf::Keyboard::PageDown)) {
+                    if (game.state == Game::Simulation) {
+                        game.state = Game::Paused;
+                    }
+                    game.switchBranch(event.key.code == sf::Keyboard::PageDown ? 1 : -1);
+                    game.setPreviousGrid(game.getGrid());
+                }
+
+                // Changer la vitesse de la simulation
+                if (!isTyping && (event.key.code == sf::Keyboard::Left || event.key.code == sf::Keyboard::Right)) {
+                    int offset = event.key.code == sf::Keyboard::Right ? 1 : -1;
+                    speedLevel = std::max(0, std::min(speedLevelCount - 1, speedLevel + offset));
+                    timeSinceLastUpdate = 0.0f;
+                }
+
+                // Déplacer la fenêtre d'un motif .mc d'une demi-grille : la zone est dépliée à la demande
+                if (!isTyping && game.hasPattern() &&
+                    (event.key.code == sf::Keyboard::J || event.key.code == sf::Keyboard::L ||
+                     event.key.code == sf::Keyboard::I || event.key.code == sf::Keyboard::K)) {
+                    int64_t stepX = game.getGrid().getWidth() / 2;
+                    int64_t stepY = game.getGrid().getHeight() / 2;
+                    int64_t dx = event.key.code == sf::Keyboard::J ? -stepX : event.key.code == sf::Keyboard::L ? stepX : 0;
+                    int64_t dy = event.key.code == sf::Keyboard::I ? -stepY : event.key.code == sf::Keyboard::K ? stepY : 0;
+                    game.setPatternViewport(game.getPatternViewportX() + dx, game.getPatternViewportY() + dy);
+                    game.setPreviousGrid(game.getGrid());
+                    if (game.state == Game::Finished) {
+                        game.state = Game::Paused;
+                    }
+                }
+
+                // Avancer d'une seule génération en pause
+                if (!isTyping && event.key.code == sf::Keyboard::N && game.state == Game::Paused) {
+                    advanceGeneration();
+                }
+
+                // Démarrer ou arrêter l'enregistrement des générations
+                if (!isTyping && sf::Keyboard::isKeyPressed(sf::Keyboard::LControl) && event.key.code == sf::Keyboard::R) {
+                    if (game.isRecording()) {
+                        game.stopRecording();
+                    } else {
+                        game.startRecording("enregistrement-" + std::to_string(std::time(nullptr)) + Recording::Extension);
+                    }
+                }
+
                 if (game.state == Game::Edition || (isEditing && (game.state == Game::Paused || game.state == Game::Finished))) {
                     int mouseX = sf::Mouse::getPosition(window).x;
                     int mouseY = sf::Mouse::getPosition(window).y;
 
-                    int cellX = mouseX / cellSize;
-                    int cellY = mouseY / cellSize;
+                    int cellX = static_cast<int>(mouseX / boardScale);
+                    int cellY = static_cast<int>(mouseY / boardScale);
 
                     // Gestion des raccourcis clavier
                     if (sf::Keyboard::isKeyPressed(sf::Keyboard::LControl) && event.key.code == sf::Keyboard::P) {
@@ -530,6 +765,13 @@ void runGraphicalMode() {
                         }
                     }
 
+                    // Barre de défilement de l'historique
+                    else if (mouseX >= scrubberTrack.getPosition().x && mouseX <= scrubberTrack.getPosition().x + scrubberTrack.getSize().x &&
+                            mouseY >= scrubberTrack.getPosition().y - 6 && mouseY <= scrubberTrack.getPosition().y + scrubberTrack.getSize().y + 6) {
+                        isScrubbing = true;
+                        scrubTo(mouseX);
+                    }
+
                     // Bouton "Edit"
                     else if (mouseX >= editButton.getPosition().x && mouseX <= editButton.getPosition().x + editButton.getSize().x &&
                             mouseY >= editButton.getPosition().y && mouseY <= editButton.getPosition().y + editButton.getSize().y) {
@@ -542,8 +784,8 @@ void runGraphicalMode() {
                     // Sélection des cellules en mode édition ou en mode édition via le crayon
                     else if (game.state == Game::Edition || (isEditing && (game.state == Game::Paused || game.state == Game::Finished))) {
                         if (mouseY < height * cellSize) {
-                            int cellX = mouseX / cellSize;
-                            int cellY = mouseY / cellSize;
+                            int cellX = static_cast<int>(mouseX / boardScale);
+                            int cellY = static_cast<int>(mouseY / boardScale);
 
                             game.getGrid().toggleCellState(cellX, cellY);
                             lastCellX = cellX;
@@ -555,8 +797,8 @@ void runGraphicalMode() {
 
                     // Placement de cellule obstacle morte
                     if (mouseY < height * cellSize) {
-                        int cellX = mouseX / cellSize;
-                        int cellY = mouseY / cellSize;
+                        int cellX = static_cast<int>(mouseX / boardScale);
+                        int cellY = static_cast<int>(mouseY / boardScale);
 
                         if (sf::Keyboard::isKeyPressed(sf::Keyboard::LControl)) {
                             game.getGrid().setCell(cellX, cellY, new DeadObstacleCell());
@@ -578,6 +820,7 @@ void runGraphicalMode() {
             if (event.type == sf::Event::MouseButtonReleased) {
                 if (event.mouseButton.button == sf::Mouse::Left) {
                     isMousePressed = false;
+                    isScrubbing = false;
                     lastCellX = -1;
                     lastCellY = -1;
                 } else if (event.mouseButton.button == sf::Mouse::Right) {
@@ -589,13 +832,17 @@ void runGraphicalMode() {
 
             // Gestion des mouvements de la souris
             if (event.type == sf::Event::MouseMoved) {
+                if (isScrubbing) {
+                    scrubTo(event.mouseMove.x);
+                }
+
                 if (isMousePressed && (game.state == Game::Edition || (isEditing && (game.state == Game::Paused || game.state == Game::Finished)))) {
                     int mouseX = event.mouseMove.x;
                     int mouseY = event.mouseMove.y;
 
                     if (mouseY < height * cellSize) {
-                        int cellX = mouseX / cellSize;
-                        int cellY = mouseY / cellSize;
+                        int cellX = static_cast<int>(mouseX / boardScale);
+                        int cellY = static_cast<int>(mouseY / boardScale);
 
                         if (cellX != lastCellX || cellY != lastCellY) {
                             game.getGrid().toggleCellState(cellX, cellY);
@@ -610,8 +857,8 @@ void runGraphicalMode() {
                     int mouseY = event.mouseMove.y;
 
                     if (mouseY < height * cellSize) {
-                        int cellX = mouseX / cellSize;
-                        int cellY = mouseY / cellSize;
+                        int cellX = static_cast<int>(mouseX / boardScale);
+                        int cellY = static_cast<int>(mouseY / boardScale);
 
                         if (cellX != lastObstacleCellX || cellY != lastObstacleCellY) {
                             Cell* currentCell = game.getGrid().getCell(cellX, cellY);
@@ -642,61 +889,37 @@ void runGraphicalMode() {
 
             // Lors de l'appui sur "Enter", sauvegarder le jeu avec le nom entré
             if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Enter && isTyping) {
-                std::string filename = userInput.toAnsiString() + ".txt";
-                game.saveToFile(filename);
-                std::cout << "Jeu sauvegardé dans " << filename << std::endl;
+                // Texte par défaut ; "nom.golb" choisit le format binaire
+                std::string filename = userInput.toAnsiString();
+                if (!Game::isSaveFile(filename)) {
+                    filename += ".txt";
+                }
+                // Écriture en arrière-plan : la fenêtre reste fluide sur les grandes grilles
+                game.saveToFileAsync(filename);
+                saveStatusText.setString("Sauvegarde : " + filename + "...");
                 isTyping = false; // Arrêter la saisie après la sauvegarde
                 userInput = "";   // Réinitialiser l'entrée de l'utilisateur
             }
         }
 
-        // Mise à jour de la grille en mode simulation
-        if (timeSinceLastUpdate > timePerFrame) {
-            if (game.state == Game::Simulation) {
-                game.saveState();  // Sauvegarder l'état actuel pour l'undo
-
-                // Obtenir la grille précédente pour comparer
-                Grid previousGrid = game.getGrid();
-
-                game.getGrid().update();
-                game.setIterations(game.getIterations() + 1);
-
-                // Comparer la grille précédente et actuelle pour compter les cellules créées et détruites
-                int cellsCreatedInThisUpdate = 0;
-                int cellsDestroyedInThisUpdate = 0;
-
-                for (int x = 0; x < width; ++x) {
-                    for (int y = 0; y < height; ++y) {
-                        Cell* previousCell = previousGrid.getCell(x, y);
-                        Cell* currentCell = game.getGrid().getCell(x, y);
-
-                        bool wasAlive = previousCell->isAlive();
-                        bool isAlive = currentCell->isAlive();
-
-                        if (!wasAlive && isAlive) {
-                            cellsCreatedInThisUpdate++;
-                        } else if (wasAlive && !isAlive) {
-                            cellsDestroyedInThisUpdate++;
-                        }
-                    }
-                }
-
-                // Mettre à jour les compteurs
-                cellsCreated += cellsCreatedInThisUpdate;
-                cellsDestroyed += cellsDestroyedInThisUpdate;
-
-                if (game.isStable()) {
-                    game.state = Game::Finished;
-                } else {
-                    game.setPreviousGrid(game.getGrid());
-                }
-
-                if (game.getIterations() >= game.getMaxIterations()) {
-                    game.state = Game::Finished;
-                }
+        // Mise à jour de la grille en mode simulation : autant de générations
+        // que la vitesse le demande, dans la limite de stepBudget par image pour
+        // que l'affichage et les événements restent fluides
+        if (game.state == Game::Simulation) {
+            sf::Clock budgetClock;
+            int rate = speedLevels[speedLevel];
+            float timePerStep = rate > 0 ? 1.0f / rate : 0.0f;
+            while (game.state == Game::Simulation && budgetClock.getElapsedTime().asSeconds() < stepBudget &&
+                   (rate == 0 || timeSinceLastUpdate >= timePerStep)) {
+                advanceGeneration();
+                timeSinceLastUpdate -= timePerStep;
             }
-
-            timeSinceLastUpdate -= timePerFrame;
+            // Retard impossible à rattraper dans le budget : abandonné plutôt qu'accumulé
+            if (rate == 0 || timeSinceLastUpdate > timePerStep) {
+                timeSinceLastUpdate = 0.0f;
+            }
+        } else {
+            timeSinceLastUpdate = 0.0f;
         }
 
         // Rendu
@@ -705,34 +928,45 @@ void runGraphicalMode() {
         // Dessiner la barre latérale
         window.draw(sidebar);
 
-        // Dessiner les cellules
-        livingCells = 0;
-
-        for (int x = 0; x < width; ++x) {
-            for (int y = 0; y < height; ++y) {
-                Cell* cell = game.getGrid().getCell(x, y);
-                if (cell->isAlive()) {
-                    livingCells++;
-                    if (dynamic_cast<ObstacleCell*>(cell)) {
-                        cellShape.setFillColor(sf::Color(128, 128, 128));  // Obstacles vivants
-                    } else {
-                        cellShape.setFillColor(sf::Color::White);  // Cellules vivantes normales
-                    }
-                    cellShape.setPosition(x * cellSize, y * cellSize);
-                    window.draw(cellShape);
-                } else if (dynamic_cast<DeadObstacleCell*>(cell)) {
-                    cellShape.setFillColor(sf::Color::Red);  // Obstacles morts (rouges)
-                    cellShape.setPosition(x * cellSize, y * cellSize);
-                    window.draw(cellShape);
-                } else if (dynamic_cast<ObstacleCell*>(cell)) {
-                    cellShape.setFillColor(sf::Color(64, 64, 64));  // Obstacles morts classiques
-                    cellShape.setPosition(x * cellSize, y * cellSize);
-                    window.draw(cellShape);
+        // Dessiner les cellules : seules les zones changées depuis l'image
+        // précédente sont envoyées à la texture, dessinée en une fois
+        const Grid& grid = game.getGrid();
+        if (boardTexture.getSize().x != static_cast<unsigned>(grid.getWidth()) ||
+            boardTexture.getSize().y != static_cast<unsigned>(grid.getHeight())) {
+            if (!boardTexture.create(grid.getWidth(), grid.getHeight())) {
+                std::cerr << "Erreur : grille trop grande pour une texture" << std::endl;
+                window.close();
+                continue;
+            }
+            boardSprite.setTexture(boardTexture, true);
+            boardImage.invalidate();
+            // La grille occupe la zone du plateau ; les cellules gardent un séparateur d'un pixel
+            // tant qu'elles font au moins 4 pixels de côté
+            boardScale = std::min(static_cast<float>(width * cellSize) / grid.getWidth(),
+                                  static_cast<float>(height * cellSize) / grid.getHeight());
+            boardSprite.setScale(boardScale, boardScale);
+            gridLines.clear();
+            if (boardScale >= 4) {
+                float right = grid.getWidth() * boardScale;
+                float bottom = grid.getHeight() * boardScale;
+                for (int x = 1; x <= grid.getWidth(); ++x) {
+                    gridLines.append(sf::Vertex(sf::Vector2f(x * boardScale - 0.5f, 0), sf::Color::Black));
+                    gridLines.append(sf::Vertex(sf::Vector2f(x * boardScale - 0.5f, bottom), sf::Color::Black));
+                }
+                for (int y = 1; y <= grid.getHeight(); ++y) {
+                    gridLines.append(sf::Vertex(sf::Vector2f(0, y * boardScale - 0.5f), sf::Color::Black));
+                    gridLines.append(sf::Vertex(sf::Vector2f(right, y * boardScale - 0.5f), sf::Color::Black));
                 }
             }
         }
+        for (const BoardImage::Region& region : boardImage.render(grid)) {
+            boardTexture.update(boardImage.getRegionPixels(region), region.width, region.height, region.x, region.y);
+        }
+        window.draw(boardSprite);
+        window.draw(gridLines);
 
-        deadCells = (width * height) - livingCells;
+        livingCells = grid.countAlive();
+        deadCells = grid.getWidth() * grid.getHeight() - livingCells;
 
         // Mettre à jour le texte du score
         livingCellsText.setString("Cellules vivantes : " + std::to_string(livingCells));
@@ -752,6 +986,53 @@ void runGraphicalMode() {
         textY += 30;
         cellsDestroyedText.setPosition(textX, textY);
 
+        // Mettre à jour la barre de défilement
+        size_t timelineFirst = game.getTimelineBegin();
+        size_t timelineLast = game.getTimelineEnd() - 1;
+        size_t timelinePosition = game.getTimelinePosition();
+        float handleRatio = timelineLast > timelineFirst
+            ? static_cast<float>(timelinePosition - timelineFirst) / (timelineLast - timelineFirst)
+            : 1.0f;
+        scrubberHandle.setPosition(scrubberTrack.getPosition().x + handleRatio * scrubberTrack.getSize().x - scrubberHandle.getSize().x / 2.0f,
+                                   scrubberTrack.getPosition().y - 6);
+        scrubberText.setString("Génération : " + std::to_string(timelinePosition) + " / " + std::to_string(timelineLast));
+        branchText.setString("Branche : " + std::to_string(game.getBranchIndex() + 1) + " / " + std::to_string(game.getBranchCount()));
+
+        if (game.isRecording()) {
+            recordingText.setString("Enregistrement : " + std::to_string(game.getRecordedFrames()) + " gén.");
+        } else if (game.isReplaying()) {
+            recordingText.setString("Relecture : " + std::to_string(game.getReplayPosition() + 1) + " / " +
+                                    std::to_string(game.getReplayLength()));
+        } else {
+            recordingText.setString("");
+        }
+
+        // Vitesse demandée et vitesse obtenue, mesurée toutes les demi-secondes
+        if (rateClock.getElapsedTime().asSeconds() >= 0.5f) {
+            measuredRate = generationsSinceRate / rateClock.restart().asSeconds();
+            generationsSinceRate = 0;
+            // Parcourt tout l'historique : relevé au même rythme que la vitesse
+            historyText.setString("Historique : " + megabytes(game.getHistoryMemoryUsage()) + " / " +
+                                  megabytes(game.getHistoryLogicalMemoryUsage()) +
+                                  "\nDisque : " + megabytes(game.getHistoryDiskUsage()) + " / " +
+                                  megabytes(game.getHistoryLogicalDiskUsage()) +
+                                  "\nTuiles distinctes : " + std::to_string(game.getTileStore().uniqueTiles()));
+        }
+        std::string speedName = speedLevels[speedLevel] > 0 ? std::to_string(speedLevels[speedLevel]) + " gén./s" : "illimitée";
+        speedText.setString("Vitesse : " + speedName + " (" + std::to_string(static_cast<int>(measuredRate + 0.5f)) + " gén./s)");
+
+        // Sauvegardes terminées depuis la dernière image
+        SaveQueue::Result saveResult;
+        while (game.pollSaveResult(saveResult)) {
+            std::string savedName = saveResult.path.substr(saveResult.path.find_last_of('/') + 1);
+            if (saveResult.success) {
+                std::cout << "Sauvegarde terminée dans " << saveResult.path << std::endl;
+                saveStatusText.setString("Sauvegardé : " + savedName);
+            } else {
+                saveStatusText.setString("Échec de la sauvegarde : " + savedName);
+            }
+        }
+
         // Dessiner les boutons en fonction de l'état du jeu
         if (game.state == Game::Edition) {
             window.draw(playButton);
@@ -795,6 +1076,16 @@ void runGraphicalMode() {
         window.draw(cellsCreatedText);
         window.draw(cellsDestroyedText);
 
+        // Dessiner la barre de défilement de l'historique
+        window.draw(scrubberText);
+        window.draw(scrubberTrack);
+        window.draw(scrubberHandle);
+        window.draw(branchText);
+        window.draw(saveStatusText);
+        window.draw(recordingText);
+        window.draw(speedText);
+        window.draw(historyText);
+
         // Dessiner le bouton "Exit"
         window.draw(exitButton);
         window.draw(exitSymbol);
@@ -987,11 +1278,46 @@ void runGraphicalMode() {
             shortcut4.setFillColor(sf::Color::Black);
             shortcut4.setPosition(iconX + 20, y);
 
+            y += 20;
+
+            sf::Text shortcut5("- Page préc. / Page suiv. : Changer de branche de l'historique.", font, 14);
+            shortcut5.setFillColor(sf::Color::Black);
+            shortcut5.setPosition(iconX + 20, y);
+
+            y += 20;
+
+            sf::Text shortcut6("- Ctrl + R : Démarrer / arrêter l'enregistrement (.golr).", font, 14);
+            shortcut6.setFillColor(sf::Color::Black);
+            shortcut6.setPosition(iconX + 20, y);
+
+            y += 20;
+
+            sf::Text shortcut7("- Flèches gauche / droite : Ralentir / accélérer (jusqu'à illimitée).", font, 14);
+            shortcut7.setFillColor(sf::Color::Black);
+            shortcut7.setPosition(iconX + 20, y);
+
+            y += 20;
+
+            sf::Text shortcut8("- N : Avancer d'une génération (en pause).", font, 14);
+            shortcut8.setFillColor(sf::Color::Black);
+            shortcut8.setPosition(iconX + 20, y);
+
+            y += 20;
+
+            sf::Text shortcut9("- I / J / K / L : Déplacer la fenêtre d'un motif .mc.", font, 14);
+            shortcut9.setFillColor(sf::Color::Black);
+            shortcut9.setPosition(iconX + 20, y);
+
             window.draw(shortcutsText);
             window.draw(shortcut1);
             window.draw(shortcut2);
             window.draw(shortcut3);
             window.draw(shortcut4);
+            window.draw(shortcut5);
+            window.draw(shortcut6);
+            window.draw(shortcut7);
+            window.draw(shortcut8);
+            window.draw(shortcut9);
         }
 
         // Afficher le champ de saisie si l'utilisateur est en train de taper
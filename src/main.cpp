@@ -1,20 +1,235 @@
 // main.cpp
 
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
-#include <fstream>
-#include <filesystem>
-#include <vector>
-#include <thread>
-#include <SFML/Graphics.hpp>
+#include <string>
 
 // Inclure les fichiers d'en-tête pour les modes console et graphique
 #include "console.h"
 #include "graphics.h"
+#include "components/Grid.h"
+#include "services/Game.h"
 
-// Namespace pour le système de fichiers
-namespace fs = std::filesystem;
+namespace {
+
+// Options de lancement ; sans argument, le mode est choisi dans un menu
+struct CommandLine {
+    std::string mode = "console"; // "console", "graphique" ou "batch"
+    std::string input;
+    std::string output;
+    std::string rule;
+    std::string metrics;
+    std::string snapshots;
+    uint64_t snapshotInterval = 100;
+    uint64_t snapshotQueue = 4;
+    bool dropOldest = false;
+    std::string engine = "tuiles";
+    uint64_t generations = 0;     // 0 : valeur par défaut du mode
+    uint64_t statsInterval = 0;
+    int64_t speed = -1;           // -1 : vitesse par défaut de la console
+    unsigned threads = 0;         // 0 : un par cœur
+};
+
+void printUsage(const char* program) {
+    std::cerr << "Usage : " << program << " [options]\n"
+              << "  -m, --mode console|graphique|batch  (console par défaut)\n"
+              << "  -i, --input <fichier>        sauvegarde de départ (tout format lu par le jeu)\n"
+              << "  -o, --output <fichier>       état final, format selon l'extension\n"
+              << "  -r, --rule <B3/S23>          règle imposée à la place de celle de la sauvegarde\n"
+              << "  -g, --generations <n>        nombre de générations (console : 100, batch : 1000)\n"
+              << "  -v, --speed <n>              console : générations par seconde (100 par défaut) ; 0 : illimitée\n"
+              << "  -t, --threads <n>            threads de calcul ; 0 : un par cœur\n"
+              << "  -e, --engine tuiles          moteur de calcul\n"
+              << "  -s, --stats <n>              population relevée toutes les n générations\n"
+              << "  -M, --metrics <fichier>      statistiques par génération (.csv ou .jsonl), intervalle --stats\n"
+              << "  -S, --snapshots <modèle>     batch : état écrit dans modèle_<génération>.<ext> (.golb, .rle...)\n"
+              << "      --snapshot-every <k>     toutes les k générations (100 par défaut)\n"
+              << "      --snapshot-queue <n>     instantanés en attente d'écriture, au plus (4 par défaut)\n"
+              << "      --snapshot-overflow attendre|abandonner\n"
+              << "                               file pleine : attendre le disque ou abandonner le plus ancien\n"
+              << "      --batch [entrée [générations [sortie]]]\n"
+              << "                               équivaut à --mode batch, avec les arguments positionnels\n"
+              << "  -h, --help                   affiche cette aide\n"
+              << "Sans option, le mode est choisi dans un menu." << std::endl;
+}
+
+// Entier décimal sans signe ni espace ; strtoull accepterait " -5" ou un dépassement
+bool parseNumber(const char* text, uint64_t& value) {
+    if (!std::isdigit(static_cast<unsigned char>(*text))) {
+        return false;
+    }
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtoull(text, &end, 10);
+    return errno != ERANGE && *end == '\0';
+}
+
+bool isHelp(const std::string& option) {
+    return option == "-h" || option == "--help";
+}
+
+// Faux sur une option inconnue ou une valeur invalide (message déjà écrit)
+bool parseCommandLine(int argc, char* argv[], CommandLine& command) {
+    for (int i = 1; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--batch") {
+            // Forme positionnelle : --batch <entrée> [générations] [sortie]
+            command.mode = "batch";
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                command.input = argv[++i];
+            }
+            uint64_t number = 0;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                if (!parseNumber(argv[i + 1], number)) {
+                    std::cerr << "Erreur : nombre de générations invalide " << argv[i + 1] << std::endl;
+                    return false;
+                }
+                command.generations = number;
+                ++i;
+            }
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                command.output = argv[++i];
+            }
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Erreur : option inconnue ou sans valeur " << option << std::endl;
+            return false;
+        }
+        const char* value = argv[++i];
+        uint64_t number = 0;
+        if (option == "-m" || option == "--mode") {
+            command.mode = value;
+        } else if (option == "-i" || option == "--input") {
+            command.input = value;
+        } else if (option == "-o" || option == "--output") {
+            command.output = value;
+        } else if (option == "-r" || option == "--rule") {
+            command.rule = value;
+        } else if (option == "-M" || option == "--metrics") {
+            command.metrics = value;
+        } else if (option == "-S" || option == "--snapshots") {
+            command.snapshots = value;
+        } else if (option == "--snapshot-overflow" && (std::string(value) == "attendre" || std::string(value) == "abandonner")) {
+            command.dropOldest = std::string(value) == "abandonner";
+        } else if (option == "--snapshot-every" && parseNumber(value, number) && number != 0) {
+            command.snapshotInterval = number;
+        } else if (option == "--snapshot-queue" && parseNumber(value, number) && number != 0) {
+            command.snapshotQueue = number;
+        } else if (option == "-e" || option == "--engine") {
+            command.engine = value;
+        } else if ((option == "-g" || option == "--generations") && parseNumber(value, number)) {
+            command.generations = number;
+        } else if ((option == "-s" || option == "--stats") && parseNumber(value, number)) {
+            command.statsInterval = number;
+        } else if ((option == "-v" || option == "--speed") && parseNumber(value, number) && number <= INT32_MAX) {
+            command.speed = static_cast<int64_t>(number);
+        } else if ((option == "-t" || option == "--threads") && parseNumber(value, number) && number <= 1024) {
+            command.threads = static_cast<unsigned>(number);
+        } else {
+            std::cerr << "Erreur : option inconnue ou valeur invalide " << option << " " << value << std::endl;
+            return false;
+        }
+    }
+
+    if (command.mode != "console" && command.mode != "graphique" && command.mode != "batch") {
+        std::cerr << "Erreur : mode inconnu " << command.mode << std::endl;
+        return false;
+    }
+    // Seul moteur disponible : la grille en tuiles de 64 x 64 bits
+    if (command.engine != "tuiles") {
+        std::cerr << "Erreur : moteur inconnu " << command.engine << std::endl;
+        return false;
+    }
+    uint16_t birth, survival;
+    if (!command.rule.empty() && !GameOfLife::Grid::parseRule(command.rule, birth, survival)) {
+        std::cerr << "Erreur : règle invalide " << command.rule << std::endl;
+        return false;
+    }
+    if (command.mode != "graphique" && command.input.empty()) {
+        std::cerr << "Erreur : le mode " << command.mode << " demande un fichier d'entrée" << std::endl;
+        return false;
+    }
+    if (!command.snapshots.empty() && (command.mode != "batch" || !GameOfLife::Game::isSaveFile(command.snapshots))) {
+        std::cerr << "Erreur : instantanés réservés au mode batch, avec une extension de sauvegarde" << std::endl;
+        return false;
+    }
+    if (command.speed >= 0 && command.mode != "console") {
+        std::cerr << "Erreur : --speed est réservé au mode console" << std::endl;
+        return false;
+    }
+    if (command.mode == "console" && command.generations > static_cast<uint64_t>(INT32_MAX)) {
+        std::cerr << "Erreur : trop de générations pour le mode console" << std::endl;
+        return false;
+    }
+    if (command.mode == "graphique" &&
+        (!command.input.empty() || !command.output.empty() || !command.rule.empty() || !command.metrics.empty() ||
+         command.generations != 0)) {
+        std::cerr << "Erreur : le mode graphique n'accepte que --threads" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    // Lancement scripté : aucune question, rien n'est initialisé hors du mode choisi
+    if (argc >= 2) {
+        CommandLine command;
+        for (int i = 1; i < argc; ++i) {
+            if (isHelp(argv[i])) {
+                printUsage(argv[0]);
+                return 0;
+            }
+        }
+        if (!parseCommandLine(argc, argv, command)) {
+            printUsage(argv[0]);
+            return -1;
+        }
+        GameOfLife::Grid::setThreadCount(command.threads);
+
+        if (command.mode == "batch") {
+            GameOfLife::BatchRun::Options options;
+            options.input = command.input;
+            options.output = command.output;
+            options.rule = command.rule;
+            options.sampleInterval = command.statsInterval;
+            options.metrics = command.metrics;
+            options.metricsInterval = std::max<uint64_t>(1, command.statsInterval);
+            options.snapshots = command.snapshots;
+            options.snapshotInterval = command.snapshotInterval;
+            options.snapshotQueue = static_cast<size_t>(command.snapshotQueue);
+            options.dropOldest = command.dropOldest;
+            if (command.generations != 0) {
+                options.generations = command.generations;
+            }
+            return runBatchMode(options);
+        }
+        if (command.mode == "console") {
+            ConsoleOptions options;
+            options.input = command.input;
+            options.output = command.output;
+            options.rule = command.rule;
+            options.statsInterval = static_cast<int>(std::min<uint64_t>(command.statsInterval, INT32_MAX));
+            options.metrics = command.metrics;
+            options.metricsInterval = std::max<uint64_t>(1, command.statsInterval);
+            if (command.generations != 0) {
+                options.generations = static_cast<int>(command.generations);
+            }
+            if (command.speed >= 0) {
+                options.speed = static_cast<int>(command.speed);
+            }
+            return runConsoleMode(options);
+        }
+        runGraphicalMode();
+        return 0;
+    }
 
-int main() {
     // Menu de sélection du mode
     std::cout << "Bienvenue dans le Jeu de la Vie !" << std::endl;
     std::cout << "Sélectionnez le mode à exécuter :" << std::endl;
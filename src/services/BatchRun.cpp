@@ -0,0 +1,199 @@
+// BatchRun.cpp
+#include "services/BatchRun.h"
+#include "services/Game.h"
+#include "services/SaveIndex.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace GameOfLife {
+namespace BatchRun {
+
+namespace {
+
+const uint64_t MaxSamples = 1000;
+const int MaxPatternLevel = 14;  // Un motif .mc est déplié en entier : 16384 cellules de côté au plus
+
+// Empreinte des cellules vivantes : somme des empreintes des tuiles, tenue à
+// jour en ne relisant que les tuiles remplacées par la dernière génération
+// (une tuile inchangée garde son pointeur)
+class GridHash {
+public:
+    explicit GridHash(const Grid& grid) : tiles(grid.getTileCount()), tileHashes(grid.getTileCount()), hash(0) {
+        for (int t = 0; t < grid.getTileCount(); ++t) {
+            tiles[t] = grid.getSharedTile(t);
+            tileHashes[t] = hashTile(grid, t);
+            hash += tileHashes[t];
+        }
+    }
+
+    uint64_t update(const Grid& grid) {
+        for (int t = 0; t < grid.getTileCount(); ++t) {
+            if (grid.getSharedTile(t) != tiles[t]) {
+                tiles[t] = grid.getSharedTile(t);
+                hash -= tileHashes[t];
+                tileHashes[t] = hashTile(grid, t);
+                hash += tileHashes[t];
+            }
+        }
+        return hash;
+    }
+
+    uint64_t value() const { return hash; }
+
+private:
+    // Tuiles déjà lues ; les garder en vie évite qu'une nouvelle tuile reprenne leur adresse
+    std::vector<std::shared_ptr<Grid::Tile>> tiles;
+    std::vector<uint64_t> tileHashes;
+    uint64_t hash;
+
+    static uint64_t hashTile(const Grid& grid, int t) {
+        if (grid.getSharedTile(t) == Grid::emptyTile()) {
+            return 0;
+        }
+        uint64_t tileHash = static_cast<uint64_t>(t) + 1;
+        const Grid::Tile& tile = grid.getTile(t);
+        for (int r = 0; r < Grid::TileSize; ++r) {
+            tileHash = (tileHash ^ tile.alive[r]) * 0xFF51AFD7ED558CCDULL;
+            tileHash ^= tileHash >> 32;
+        }
+        return tileHash * 0xC4CEB9FE1A85EC53ULL;
+    }
+};
+
+// Une empreinte commune ne suffit pas : la grille doit revenir à elle-même
+// après period générations
+bool hasPeriod(const Grid& grid, uint64_t period) {
+    Grid later(grid);
+    for (uint64_t i = 0; i < period; ++i) {
+        later.update();
+    }
+    return later == grid;
+}
+
+}
+
+bool run(const Options& options, Summary& summary) {
+    Grid loaded(1, 1);
+    Quadtree tree;
+    uint64_t generation = 0;
+    bool isPattern = false;
+    if (!SaveIndex::readSave(options.input, loaded, tree, generation, isPattern)) {
+        std::cerr << "Erreur : impossible de charger " << options.input << std::endl;
+        return false;
+    }
+    if (isPattern) {
+        if (tree.getRootLevel() > MaxPatternLevel) {
+            std::cerr << "Erreur : motif " << options.input << " trop grand pour être déplié" << std::endl;
+            return false;
+        }
+        int side = 1 << tree.getRootLevel();
+        Grid flat(side, side);
+        flat.setRule(loaded.getBirthMask(), loaded.getSurvivalMask());
+        tree.flatten(flat, 0, 0);
+        loaded = std::move(flat);
+    }
+
+    if (!options.rule.empty()) {
+        uint16_t birth, survival;
+        if (!Grid::parseRule(options.rule, birth, survival)) {
+            std::cerr << "Erreur : règle invalide " << options.rule << std::endl;
+            return false;
+        }
+        loaded.setRule(birth, survival);
+    }
+
+    // Même calcul que les autres modes (relevés, instantanés), sans historique
+    Game game(1, 1, 0);
+    game.setHistoryEnabled(false);
+    Grid& grid = game.getGrid();
+    grid = std::move(loaded);
+    game.setIterations(generation);
+
+    summary = Summary();
+    summary.sampleInterval = options.sampleInterval != 0
+        ? options.sampleInterval
+        : std::max<uint64_t>(1, (options.generations + MaxSamples - 1) / MaxSamples);
+    summary.population.push_back(static_cast<uint64_t>(grid.countAlive()));
+
+    // Empreintes des dernières générations, pour la détection des cycles
+    GridHash hash(grid);
+    std::vector<uint64_t> recent(options.maxPeriod, 0);
+    if (options.maxPeriod != 0) {
+        recent[0] = hash.value();
+    }
+
+    if (!options.snapshots.empty()) {
+        size_t slash = options.snapshots.find_last_of("/\\");
+        size_t dot = options.snapshots.find_last_of('.');
+        if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+            dot = options.snapshots.size();
+        }
+        game.startSnapshots(options.snapshots.substr(0, dot), options.snapshots.substr(dot), options.snapshotInterval,
+                            options.snapshotQueue, options.dropOldest ? SaveQueue::DropOldest : SaveQueue::Block);
+    }
+
+    if (!options.metrics.empty() && !game.startMetrics(options.metrics, options.metricsInterval)) {
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    while (summary.generations < options.generations) {
+        game.step();
+        ++summary.generations;
+        if (summary.generations % summary.sampleInterval == 0) {
+            summary.population.push_back(static_cast<uint64_t>(grid.countAlive()));
+        }
+        if (options.maxPeriod == 0) {
+            continue;
+        }
+        uint64_t value = hash.update(grid);
+        uint64_t known = std::min(summary.generations, options.maxPeriod);
+        for (uint64_t period = 1; period <= known; ++period) {
+            if (recent[(summary.generations - period) % options.maxPeriod] == value && hasPeriod(grid, period)) {
+                summary.period = period;
+                break;
+            }
+        }
+        if (summary.period != 0) {
+            break;
+        }
+        recent[summary.generations % options.maxPeriod] = value;
+    }
+    summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    bool snapshotsWritten = game.stopSnapshots();
+    summary.snapshotsDropped = game.getDroppedSnapshots();
+    if (!game.stopMetrics() || !snapshotsWritten) {
+        return false;
+    }
+
+    // Dernier relevé : l'état final, même hors intervalle
+    if (summary.generations % summary.sampleInterval != 0) {
+        summary.population.push_back(static_cast<uint64_t>(grid.countAlive()));
+    }
+    if (!options.output.empty()) {
+        if (!game.saveToPath(options.output)) {
+            std::cerr << "Erreur : impossible d'écrire " << options.output << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+void printSummary(const Summary& summary, std::ostream& out) {
+    out << "generations=" << summary.generations << "\n";
+    out << "secondes=" << summary.seconds << "\n";
+    out << "generations_par_seconde=" << (summary.seconds > 0 ? summary.generations / summary.seconds : 0.0) << "\n";
+    out << "fin=" << (summary.period == 1 ? "stable" : summary.period != 0 ? "periodique" : "limite") << "\n";
+    out << "periode=" << summary.period << "\n";
+    out << "intervalle_population=" << summary.sampleInterval << "\n";
+    out << "instantanes_perdus=" << summary.snapshotsDropped << "\n";
+    out << "population=";
+    for (size_t i = 0; i < summary.population.size(); ++i) {
+        out << (i ? "," : "") << summary.population[i];
+    }
+    out << std::endl;
+}
+
+}
+}
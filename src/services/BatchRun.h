@@ -0,0 +1,47 @@
+// BatchRun.h
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace GameOfLife {
+
+// Simulation sans affichage ni pause, pour les lancements en série depuis
+// des scripts : au plus N générations, arrêt anticipé sur un état stable ou
+// périodique, puis écriture de l'état final et d'un résumé.
+namespace BatchRun {
+
+struct Options {
+    std::string input;            // Sauvegarde de départ (tout format de Game)
+    std::string output;           // État final, format selon l'extension ; vide : pas d'écriture
+    std::string rule;             // Règle imposée ("B3/S23") ; vide : celle de la sauvegarde
+    uint64_t generations = 1000;
+    uint64_t maxPeriod = 64;      // Période la plus longue détectée ; 0 : pas de détection
+    uint64_t sampleInterval = 0;  // Population relevée toutes les n générations ; 0 : au plus 1000 relevés
+    std::string metrics;          // Statistiques par génération (.csv ou .jsonl) ; vide : aucune
+    uint64_t metricsInterval = 1;
+    // Instantanés : "dossier/etat.rle" donne dossier/etat_<génération>.rle ; vide : aucun
+    std::string snapshots;
+    uint64_t snapshotInterval = 100;
+    size_t snapshotQueue = 4;     // Instantanés en attente d'écriture, au plus
+    bool dropOldest = false;      // File pleine : abandon du plus ancien au lieu d'attendre le disque
+};
+
+struct Summary {
+    uint64_t generations = 0;     // Générations calculées
+    double seconds = 0;           // Durée du calcul seul (hors chargement et écriture)
+    uint64_t period = 0;          // 1 : état stable ; 0 : aucun cycle détecté
+    uint64_t sampleInterval = 1;
+    std::vector<uint64_t> population;  // Relevés successifs, génération de départ incluse
+    uint64_t snapshotsDropped = 0;
+};
+
+bool run(const Options& options, Summary& summary);
+
+// Une ligne "clé=valeur" par statistique, facile à analyser par un script
+void printSummary(const Summary& summary, std::ostream& out);
+
+}
+
+}
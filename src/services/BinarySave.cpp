@@ -0,0 +1,264 @@
+// BinarySave.cpp
+#include "services/BinarySave.h"
+#include "services/TileStore.h"
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace GameOfLife {
+namespace BinarySave {
+
+namespace {
+
+const size_t HeaderSize = 64;
+const size_t Alignment = 64;
+const uint32_t ToroidalFlag = 1;
+const uint32_t ObstacleFlag = 2;
+
+size_t align(size_t offset) {
+    return (offset + Alignment - 1) / Alignment * Alignment;
+}
+
+// Les tuiles sont écrites telles qu'en mémoire : l'hôte doit être little-endian
+bool littleEndianHost() {
+    uint16_t probe = 1;
+    uint8_t first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+void put(uint8_t* out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+uint64_t get(const uint8_t* in, int bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) {
+        value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+bool hasObstacles(const Grid::Tile& tile) {
+    for (int r = 0; r < Grid::TileSize; ++r) {
+        if (tile.obstacle[r] | tile.deadObstacle[r]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Bits hors de la grille (tuiles du bord droit ou du bas) : doivent être nuls
+bool cleanEdges(const Grid::Tile& tile, int validWidth, int validHeight) {
+    uint64_t outside = validWidth >= Grid::TileSize ? 0 : ~((1ULL << validWidth) - 1);
+    for (int r = 0; r < Grid::TileSize; ++r) {
+        uint64_t mask = r < validHeight ? outside : ~0ULL;
+        if ((tile.alive[r] | tile.obstacle[r] | tile.deadObstacle[r]) & mask) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Projection privée du fichier : les écritures sur les tuiles ne touchent pas le disque
+std::shared_ptr<uint8_t> mapFile(const std::string& path, size_t& size) {
+#ifdef _WIN32
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return nullptr;
+    }
+    size = static_cast<size_t>(file.tellg());
+    auto buffer = std::make_shared<std::vector<uint64_t>>((size + 7) / 8);
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(buffer->data()), static_cast<std::streamsize>(size));
+    if (!file) {
+        return nullptr;
+    }
+    return std::shared_ptr<uint8_t>(buffer, reinterpret_cast<uint8_t*>(buffer->data()));
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    size = static_cast<size_t>(info.st_size);
+    void* address = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        return nullptr;
+    }
+    size_t length = size;
+    return std::shared_ptr<uint8_t>(static_cast<uint8_t*>(address),
+                                    [length](uint8_t* p) { ::munmap(p, length); });
+#endif
+}
+
+}
+
+bool write(const std::string& path, const Grid& grid, uint64_t generation) {
+    if (!littleEndianHost()) {
+        std::cerr << "Erreur : format binaire non pris en charge sur cette architecture" << std::endl;
+        return false;
+    }
+
+    // Table des tuiles : les tuiles vides ne sont pas stockées, les tuiles
+    // identiques une seule fois. TileStore remplace chacune par un exemplaire
+    // canonique (une tuile nulle par la tuile vide partagée) : comparer les
+    // pointeurs suffit ensuite.
+    Grid canonical(grid);
+    TileStore store;
+    store.intern(canonical);
+    const int tileCount = canonical.getTileCount();
+    std::vector<uint32_t> table(tileCount, 0);
+    std::vector<const Grid::Tile*> stored;
+    std::unordered_map<const Grid::Tile*, uint32_t> byPointer;
+    bool obstacles = false;
+
+    for (int i = 0; i < tileCount; ++i) {
+        const Grid::Tile* tile = canonical.getSharedTile(i).get();
+        if (canonical.getSharedTile(i) == Grid::emptyTile()) {
+            continue;
+        }
+        auto known = byPointer.find(tile);
+        if (known != byPointer.end()) {
+            table[i] = known->second;
+            continue;
+        }
+        stored.push_back(tile);
+        table[i] = byPointer[tile] = static_cast<uint32_t>(stored.size());
+        obstacles = obstacles || hasObstacles(*tile);
+    }
+
+    size_t indexOffset = HeaderSize;
+    size_t tilesOffset = align(indexOffset + table.size() * sizeof(uint32_t));
+
+    uint8_t header[HeaderSize] = {};
+    std::memcpy(header, "GOLB", 4);
+    put(header + 4, Version, 2);
+    put(header + 6, HeaderSize, 2);
+    put(header + 8, grid.getWidth(), 4);
+    put(header + 12, grid.getHeight(), 4);
+    put(header + 16, grid.getBirthMask(), 2);
+    put(header + 18, grid.getSurvivalMask(), 2);
+    put(header + 20, (grid.isToroidal() ? ToroidalFlag : 0) | (obstacles ? ObstacleFlag : 0), 4);
+    put(header + 24, generation, 8);
+    put(header + 32, Grid::TileSize, 4);
+    put(header + 36, stored.size(), 4);
+    put(header + 40, indexOffset, 8);
+    put(header + 48, tilesOffset, 8);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Erreur : Impossible de créer le fichier " << path << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(header), HeaderSize);
+    file.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(uint32_t)));
+    static const char padding[Alignment] = {};
+    file.write(padding, static_cast<std::streamsize>(tilesOffset - indexOffset - table.size() * sizeof(uint32_t)));
+    for (const Grid::Tile* tile : stored) {
+        file.write(reinterpret_cast<const char*>(tile), sizeof(Grid::Tile));
+    }
+
+    if (!file) {
+        std::cerr << "Erreur : écriture incomplète de " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool read(const std::string& path, Grid& grid, uint64_t& generation) {
+    if (!littleEndianHost()) {
+        std::cerr << "Erreur : format binaire non pris en charge sur cette architecture" << std::endl;
+        return false;
+    }
+
+    size_t size = 0;
+    std::shared_ptr<uint8_t> data = mapFile(path, size);
+    if (!data) {
+        std::cerr << "Erreur lors de l'ouverture du fichier de sauvegarde " << path << std::endl;
+        return false;
+    }
+    const uint8_t* header = data.get();
+    if (size < HeaderSize || std::memcmp(header, "GOLB", 4) != 0) {
+        std::cerr << "Erreur : " << path << " n'est pas une sauvegarde binaire" << std::endl;
+        return false;
+    }
+    if (get(header + 4, 2) != Version) {
+        std::cerr << "Erreur : version " << get(header + 4, 2) << " du format binaire non prise en charge" << std::endl;
+        return false;
+    }
+
+    uint64_t width = get(header + 8, 4);
+    uint64_t height = get(header + 12, 4);
+    uint32_t flags = static_cast<uint32_t>(get(header + 20, 4));
+    uint64_t storedCount = get(header + 36, 4);
+    uint64_t indexOffset = get(header + 40, 8);
+    uint64_t tilesOffset = get(header + 48, 8);
+
+    uint64_t tilesX = (width + Grid::TileSize - 1) / Grid::TileSize;
+    uint64_t tilesY = (height + Grid::TileSize - 1) / Grid::TileSize;
+    uint64_t tileCount = tilesX * tilesY;
+    bool valid = get(header + 6, 2) >= HeaderSize && get(header + 32, 4) == Grid::TileSize &&
+                 width > 0 && height > 0 && width <= static_cast<uint64_t>(Grid::MaxDimension) &&
+                 height <= static_cast<uint64_t>(Grid::MaxDimension) && tileCount <= INT_MAX &&
+                 indexOffset >= HeaderSize && indexOffset % sizeof(uint32_t) == 0 &&
+                 indexOffset <= size && tileCount <= (size - indexOffset) / sizeof(uint32_t) &&
+                 tilesOffset % Alignment == 0 && tilesOffset <= size &&
+                 storedCount <= (size - tilesOffset) / sizeof(Grid::Tile);
+    if (!valid) {
+        std::cerr << "Erreur : en-tête invalide dans " << path << std::endl;
+        return false;
+    }
+
+    Grid loaded(static_cast<int>(width), static_cast<int>(height));
+    loaded.setToroidal((flags & ToroidalFlag) != 0);
+    loaded.setRule(static_cast<uint16_t>(get(header + 16, 2)), static_cast<uint16_t>(get(header + 18, 2)));
+
+    const uint32_t* table = reinterpret_cast<const uint32_t*>(data.get() + indexOffset);
+    Grid::Tile* tiles = reinterpret_cast<Grid::Tile*>(data.get() + tilesOffset);
+    for (uint64_t i = 0; i < tileCount; ++i) {
+        uint32_t id = table[i];
+        if (id == 0) {
+            continue;
+        }
+        if (id > storedCount) {
+            std::cerr << "Erreur : table des tuiles corrompue dans " << path << std::endl;
+            return false;
+        }
+        Grid::Tile& tile = tiles[id - 1];
+        int validWidth = static_cast<int>(width - (i % tilesX) * Grid::TileSize);
+        int validHeight = static_cast<int>(height - (i / tilesX) * Grid::TileSize);
+        if ((validWidth < Grid::TileSize || validHeight < Grid::TileSize) &&
+            !cleanEdges(tile, validWidth, validHeight)) {
+            std::cerr << "Erreur : cellules hors de la grille dans " << path << std::endl;
+            return false;
+        }
+        // La tuile pointe dans la projection, qui vit tant qu'une tuile la référence
+        loaded.replaceTile(static_cast<int>(i), std::shared_ptr<Grid::Tile>(data, &tile));
+    }
+
+    grid = std::move(loaded);
+    generation = get(header + 24, 8);
+    return true;
+}
+
+}
+}
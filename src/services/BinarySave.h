@@ -0,0 +1,39 @@
+// BinarySave.h
+#pragma once
+#include "components/Grid.h"
+#include <cstdint>
+#include <string>
+
+namespace GameOfLife {
+
+// Format binaire versionné des sauvegardes (extension .golb), un bit par cellule.
+//
+// En-tête de 64 octets (little-endian) :
+//   0  "GOLB"            4  version (u16)       6  taille de l'en-tête (u16)
+//   8  largeur (u32)     12 hauteur (u32)
+//   16 naissance (u16)   18 survie (u16)        20 drapeaux (u32 : 1 torique, 2 obstacles)
+//   24 génération (u64)
+//   32 taille de tuile (u32)                    36 nombre de tuiles stockées (u32)
+//   40 position de la table des tuiles (u64)    48 position des tuiles (u64)
+// Table : un u32 par tuile de la grille (ligne par ligne), 0 pour une tuile
+// vide, k pour la k-ième tuile stockée. Les tuiles identiques ne sont
+// stockées qu'une fois.
+// Tuiles : enregistrements Grid::Tile (plans alive, obstacle, deadObstacle,
+// 64 mots de 64 bits chacun, bit x de la ligne y = cellule), alignés sur 64 octets.
+//
+// Au chargement, le fichier est projeté en mémoire (copie privée) et les
+// tuiles de la grille pointent directement dans la projection : aucun décodage.
+namespace BinarySave {
+
+const char Extension[] = ".golb";
+const uint16_t Version = 1;
+
+bool write(const std::string& path, const Grid& grid, uint64_t generation);
+
+// Remplace grid par le contenu du fichier. Retourne false (message sur
+// std::cerr) si le fichier est absent, d'une autre version ou corrompu.
+bool read(const std::string& path, Grid& grid, uint64_t& generation);
+
+}
+
+}
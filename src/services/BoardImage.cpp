@@ -0,0 +1,127 @@
+// BoardImage.cpp
+#include "services/BoardImage.h"
+#include <algorithm>
+#include <cstring>
+
+namespace GameOfLife {
+
+namespace {
+
+uint32_t rgba(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    const uint8_t bytes[4] = {r, g, b, a};
+    uint32_t pixel;
+    std::memcpy(&pixel, bytes, sizeof(pixel));
+    return pixel;
+}
+
+}
+
+BoardImage::BoardImage() : width(0), height(0), hasFrame(false), presented(1, 1) {
+    const uint32_t transparent = rgba(0, 0, 0, 0);
+    const uint32_t alive = rgba(255, 255, 255, 255);
+    const uint32_t red = rgba(255, 0, 0, 255);
+    palette[0] = transparent;
+    palette[1] = alive;
+    palette[2] = rgba(64, 64, 64, 255);    // Obstacle mort classique
+    palette[3] = rgba(128, 128, 128, 255); // Obstacle vivant
+    palette[4] = transparent;              // Combinaisons sans obstacle : comme une cellule ordinaire
+    palette[5] = alive;
+    palette[6] = red;                      // Obstacle de type DeadObstacleCell
+    palette[7] = red;
+    for (int byte = 0; byte < 256; ++byte) {
+        for (int bit = 0; bit < 8; ++bit) {
+            aliveBytes[byte][bit] = palette[(byte >> bit) & 1];
+        }
+    }
+}
+
+const std::vector<BoardImage::Region>& BoardImage::render(const Grid& grid) {
+    regions.clear();
+    bool full = !hasFrame || grid.getWidth() != width || grid.getHeight() != height;
+    if (grid.getWidth() != width || grid.getHeight() != height) {
+        width = grid.getWidth();
+        height = grid.getHeight();
+        pixels.assign(static_cast<size_t>(width) * height, palette[0]);
+    }
+
+    // Tuiles changées : au-delà de la moitié, un seul envoi du plateau entier coûte moins
+    std::vector<int> changed;
+    for (int index = 0; !full && index < grid.getTileCount(); ++index) {
+        if (!grid.sharesTile(presented, index)) {
+            changed.push_back(index);
+        }
+    }
+    full = full || changed.size() * 2 > static_cast<size_t>(grid.getTileCount());
+
+    if (full) {
+        for (int index = 0; index < grid.getTileCount(); ++index) {
+            renderTile(grid, index);
+        }
+        regions.push_back(Region{0, 0, width, height});
+    } else {
+        // Tuiles voisines d'une même rangée réunies en une zone
+        for (size_t i = 0; i < changed.size(); ++i) {
+            int index = changed[i];
+            renderTile(grid, index);
+            int tx = index % grid.getTilesX();
+            int x = tx * Grid::TileSize;
+            int y = (index / grid.getTilesX()) * Grid::TileSize;
+            int right = std::min(width, x + Grid::TileSize);
+            if (i > 0 && changed[i - 1] == index - 1 && tx > 0) {
+                regions.back().width = right - regions.back().x;
+            } else {
+                regions.push_back(Region{x, y, right - x, std::min(Grid::TileSize, height - y)});
+            }
+        }
+    }
+    presented = grid;
+    hasFrame = true;
+    return regions;
+}
+
+void BoardImage::invalidate() {
+    hasFrame = false;
+}
+
+const uint8_t* BoardImage::getRegionPixels(const Region& region) {
+    if (region.x == 0 && region.width == width) {
+        return reinterpret_cast<const uint8_t*>(pixels.data() + static_cast<size_t>(region.y) * width);
+    }
+    regionPixels.resize(static_cast<size_t>(region.width) * region.height);
+    for (int r = 0; r < region.height; ++r) {
+        const uint32_t* source = pixels.data() + static_cast<size_t>(region.y + r) * width + region.x;
+        std::copy(source, source + region.width, regionPixels.data() + static_cast<size_t>(r) * region.width);
+    }
+    return reinterpret_cast<const uint8_t*>(regionPixels.data());
+}
+
+void BoardImage::renderTile(const Grid& grid, int index) {
+    const int x0 = (index % grid.getTilesX()) * Grid::TileSize;
+    const int y0 = (index / grid.getTilesX()) * Grid::TileSize;
+    const int tileWidth = std::min(Grid::TileSize, width - x0);
+    const int tileHeight = std::min(Grid::TileSize, height - y0);
+    const Grid::Tile& tile = grid.getTile(index);
+
+    for (int r = 0; r < tileHeight; ++r) {
+        uint32_t* row = pixels.data() + static_cast<size_t>(y0 + r) * width + x0;
+        uint64_t alive = tile.alive[r];
+        uint64_t obstacle = tile.obstacle[r];
+        uint64_t deadObstacle = tile.deadObstacle[r];
+        if ((alive | obstacle | deadObstacle) == 0) {
+            std::fill(row, row + tileWidth, palette[0]);
+            continue;
+        }
+        int x = 0;
+        if ((obstacle | deadObstacle) == 0) {
+            // Cas courant sans obstacle : 8 pixels recopiés par octet de la ligne
+            for (; x + 8 <= tileWidth; x += 8) {
+                std::memcpy(row + x, aliveBytes[(alive >> x) & 0xFF], sizeof(aliveBytes[0]));
+            }
+        }
+        for (; x < tileWidth; ++x) {
+            row[x] = palette[((alive >> x) & 1) | (((obstacle >> x) & 1) << 1) | (((deadObstacle >> x) & 1) << 2)];
+        }
+    }
+}
+
+}
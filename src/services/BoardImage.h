@@ -0,0 +1,57 @@
+// BoardImage.h
+#pragma once
+#include "components/Grid.h"
+#include <cstdint>
+#include <vector>
+
+namespace GameOfLife {
+
+// Image RGBA du plateau, un pixel par cellule, ligne par ligne : le mode
+// graphique la charge dans une texture agrandie à l'affichage, au lieu de
+// dessiner chaque cellule. Les cellules mortes sont transparentes (fond de
+// la fenêtre).
+// Seules les tuiles qui ne sont plus partagées avec la dernière grille
+// rendue sont recalculées, et renvoyées comme zones à recharger : le volume
+// envoyé à la texture suit l'activité du plateau, pas sa taille.
+class BoardImage {
+public:
+    // Zone modifiée, en cellules
+    struct Region {
+        int x;
+        int y;
+        int width;
+        int height;
+    };
+
+    BoardImage();
+
+    // Met à jour l'image et renvoie les zones changées depuis l'appel
+    // précédent (une seule zone, le plateau entier, au premier appel, après
+    // invalidate() ou quand plus de la moitié des tuiles a changé)
+    const std::vector<Region>& render(const Grid& grid);
+    void invalidate();
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    const uint8_t* getPixels() const { return reinterpret_cast<const uint8_t*>(pixels.data()); }
+
+    // Pixels d'une zone, contigus ligne par ligne (pour sf::Texture::update) ;
+    // valables jusqu'à l'appel suivant
+    const uint8_t* getRegionPixels(const Region& region);
+
+private:
+    int width;
+    int height;
+    std::vector<uint32_t> pixels;  // Octets r, g, b, a de chaque pixel
+    uint32_t palette[8];           // Par combinaison vivante | obstacle << 1 | obstacle mort << 2
+    uint32_t aliveBytes[256][8];   // Pixels de 8 cellules sans obstacle, par octet de vivantes
+
+    bool hasFrame;
+    Grid presented;                // Dernière grille rendue (copie des pointeurs de tuiles)
+    std::vector<Region> regions;
+    std::vector<uint32_t> regionPixels;
+
+    void renderTile(const Grid& grid, int index);
+};
+
+}
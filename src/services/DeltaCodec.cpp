@@ -0,0 +1,124 @@
+// DeltaCodec.cpp
+#include "services/DeltaCodec.h"
+#include <cstring>
+
+namespace GameOfLife {
+namespace DeltaCodec {
+
+void writeVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+bool readVarint(const std::vector<uint8_t>& in, size_t& pos, uint64_t& value) {
+    value = 0;
+    int shift = 0;
+    while (pos < in.size() && shift < 64) {
+        uint8_t byte = in[pos++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+        shift += 7;
+    }
+    return false;
+}
+
+namespace {
+
+const int WordsPerTile = 3 * Grid::TileSize;
+
+// Mot w d'une tuile : plans alive, obstacle puis deadObstacle
+uint64_t& word(Grid::Tile& tile, int w) {
+    int r = w % Grid::TileSize;
+    switch (w / Grid::TileSize) {
+        case 0:  return tile.alive[r];
+        case 1:  return tile.obstacle[r];
+        default: return tile.deadObstacle[r];
+    }
+}
+
+// Ajoute au flux les mots non nuls de a XOR b pour la tuile index
+void encodeTile(std::vector<uint8_t>& out, const Grid::Tile& a, const Grid::Tile& b, int index, size_t& lastTile) {
+    const uint64_t* older[3] = {a.alive, a.obstacle, a.deadObstacle};
+    const uint64_t* newer[3] = {b.alive, b.obstacle, b.deadObstacle};
+    uint8_t positions[WordsPerTile];
+    uint64_t values[WordsPerTile];
+    int count = 0;
+    for (int plane = 0; plane < 3; ++plane) {
+        // Les obstacles ne changent presque jamais : plan comparé d'un bloc
+        if (plane > 0 && std::memcmp(older[plane], newer[plane], sizeof(a.alive)) == 0) {
+            continue;
+        }
+        for (int r = 0; r < Grid::TileSize; ++r) {
+            uint64_t x = older[plane][r] ^ newer[plane][r];
+            positions[count] = static_cast<uint8_t>(plane * Grid::TileSize + r);
+            values[count] = x;
+            count += x != 0;
+        }
+    }
+    if (count == 0) {
+        return;
+    }
+    writeVarint(out, static_cast<uint64_t>(index) - lastTile);
+    writeVarint(out, count);
+    size_t start = out.size();
+    out.resize(start + static_cast<size_t>(count) * 9);
+    uint8_t* p = out.data() + start;
+    for (int i = 0; i < count; ++i) {
+        *p++ = positions[i];
+        for (int byte = 0; byte < 8; ++byte) {
+            *p++ = static_cast<uint8_t>(values[i] >> (8 * byte));
+        }
+    }
+    lastTile = index;
+}
+
+}
+
+std::vector<uint8_t> encodeXor(const Grid& older, const Grid& newer) {
+    std::vector<uint8_t> out;
+    size_t lastTile = 0;
+    for (int i = 0; i < newer.getTileCount(); ++i) {
+        // Une tuile partagée est identique par construction
+        if (!newer.sharesTile(older, i)) {
+            encodeTile(out, older.getTile(i), newer.getTile(i), i, lastTile);
+        }
+    }
+    return out;
+}
+
+bool applyXor(const std::vector<uint8_t>& delta, Grid& grid) {
+    size_t pos = 0;
+    uint64_t index = 0;
+    while (pos < delta.size()) {
+        uint64_t gap, count;
+        if (!readVarint(delta, pos, gap) || !readVarint(delta, pos, count)) {
+            return false;
+        }
+        index += gap;
+        if (index >= static_cast<uint64_t>(grid.getTileCount()) || count > WordsPerTile ||
+            pos + count * 9 > delta.size()) {
+            return false;
+        }
+        Grid::Tile& tile = grid.getMutableTile(static_cast<int>(index));
+        for (uint64_t i = 0; i < count; ++i) {
+            int w = delta[pos++];
+            uint64_t value = 0;
+            for (int byte = 0; byte < 8; ++byte) {
+                value |= static_cast<uint64_t>(delta[pos++]) << (8 * byte);
+            }
+            if (w >= WordsPerTile) {
+                return false;
+            }
+            word(tile, w) ^= value;
+        }
+    }
+    return true;
+}
+
+}
+}
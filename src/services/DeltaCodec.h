@@ -0,0 +1,27 @@
+// DeltaCodec.h
+#pragma once
+#include "components/Grid.h"
+#include <cstdint>
+#include <vector>
+
+namespace GameOfLife {
+
+// Encodage creux du XOR entre deux grilles de même taille.
+// Seules les tuiles non partagées sont comparées ; pour chacune, le flux
+// contient (écart d'index de tuile, nombre de mots) en varint puis les mots
+// de 64 bits non nuls du XOR, précédés de leur position dans la tuile.
+namespace DeltaCodec {
+
+// Encode older XOR newer
+std::vector<uint8_t> encodeXor(const Grid& older, const Grid& newer);
+
+// Applique un delta encodé sur grid (XOR en place). Retourne false si le flux est invalide.
+bool applyXor(const std::vector<uint8_t>& delta, Grid& grid);
+
+// Entiers de longueur variable (7 bits par octet) utilisés par les flux binaires
+void writeVarint(std::vector<uint8_t>& out, uint64_t value);
+bool readVarint(const std::vector<uint8_t>& in, size_t& pos, uint64_t& value);
+
+}
+
+}
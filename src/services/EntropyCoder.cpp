@@ -0,0 +1,247 @@
+// EntropyCoder.cpp
+#include "services/EntropyCoder.h"
+#include <algorithm>
+#include <memory>
+
+namespace GameOfLife {
+namespace EntropyCoder {
+
+namespace {
+
+const int ProbabilityBits = 12;
+const uint32_t ProbabilityTotal = 1u << ProbabilityBits;
+const uint32_t LowerBound = 1u << 15;  // État normalisé dans [2^15, 2^31), sorti par mots de 16 bits
+const int States = 4;                  // États entrelacés : le symbole i utilise l'état i % 4
+
+void writeVarint(std::vector<uint8_t>& out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+bool readVarint(const uint8_t* data, size_t size, size_t& pos, uint32_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 28 && pos < size; shift += 7) {
+        uint8_t byte = data[pos++];
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Fréquences ramenées à un total de 2^12, tout symbole présent gardant au moins 1
+void normalize(const uint64_t counts[256], uint64_t total, uint32_t frequencies[256]) {
+    uint32_t sum = 0;
+    for (int s = 0; s < 256; ++s) {
+        frequencies[s] = counts[s] == 0 ? 0
+            : std::max<uint32_t>(1, static_cast<uint32_t>(counts[s] * ProbabilityTotal / total));
+        sum += frequencies[s];
+    }
+    while (sum != ProbabilityTotal) {
+        uint32_t* largest = std::max_element(frequencies, frequencies + 256);
+        if (sum < ProbabilityTotal) {
+            *largest += ProbabilityTotal - sum;
+            sum = ProbabilityTotal;
+        } else {
+            --*largest;
+            --sum;
+        }
+    }
+}
+
+// Table : une fréquence par symbole, un zéro étant suivi du nombre de zéros qui le suivent
+void writeTable(std::vector<uint8_t>& out, const uint32_t frequencies[256]) {
+    for (int s = 0; s < 256; ++s) {
+        writeVarint(out, frequencies[s]);
+        if (frequencies[s] == 0) {
+            int run = 0;
+            while (s + 1 < 256 && run < 255 && frequencies[s + 1] == 0) {
+                ++s;
+                ++run;
+            }
+            out.push_back(static_cast<uint8_t>(run));
+        }
+    }
+}
+
+bool readTable(const uint8_t* data, size_t size, size_t& pos, uint32_t frequencies[256]) {
+    uint32_t sum = 0;
+    for (int s = 0; s < 256; ++s) {
+        uint32_t frequency;
+        if (!readVarint(data, size, pos, frequency) || frequency > ProbabilityTotal) {
+            return false;
+        }
+        frequencies[s] = frequency;
+        sum += frequency;
+        if (frequency == 0) {
+            if (pos >= size || s + data[pos] >= 256) {
+                return false;
+            }
+            for (int run = data[pos++]; run > 0; --run) {
+                frequencies[++s] = 0;
+            }
+        }
+    }
+    return sum == ProbabilityTotal;
+}
+
+}
+
+std::vector<uint8_t> compress(const uint8_t* data, size_t size) {
+    std::vector<uint8_t> out;
+    if (size == 0) {
+        return out;
+    }
+    // Quatre histogrammes partiels : les incréments successifs d'un même
+    // compteur ne s'attendent plus
+    uint64_t partial[4][256] = {};
+    size_t pos = 0;
+    for (; pos + 4 <= size; pos += 4) {
+        ++partial[0][data[pos]];
+        ++partial[1][data[pos + 1]];
+        ++partial[2][data[pos + 2]];
+        ++partial[3][data[pos + 3]];
+    }
+    for (; pos < size; ++pos) {
+        ++partial[0][data[pos]];
+    }
+    uint64_t counts[256];
+    for (int s = 0; s < 256; ++s) {
+        counts[s] = partial[0][s] + partial[1][s] + partial[2][s] + partial[3][s];
+    }
+    uint32_t frequencies[256];
+    uint32_t starts[256];
+    normalize(counts, size, frequencies);
+    for (uint32_t s = 0, start = 0; s < 256; ++s) {
+        starts[s] = start;
+        start += frequencies[s];
+    }
+    writeTable(out, frequencies);
+
+    // Division par la fréquence remplacée par une multiplication par son
+    // inverse, exacte tant que l'état reste sous 2^31
+    struct Symbol {
+        uint32_t limit;
+        uint32_t reciprocal;
+        uint32_t shift;
+        uint32_t bias;
+        uint32_t complement;
+    } symbols[256];
+    for (int s = 0; s < 256; ++s) {
+        uint32_t frequency = std::max<uint32_t>(1, frequencies[s]);
+        Symbol& symbol = symbols[s];
+        symbol.limit = ((LowerBound >> ProbabilityBits) << 16) * frequency;
+        symbol.complement = ProbabilityTotal - frequency;
+        if (frequency == 1) {
+            symbol.reciprocal = ~0u;
+            symbol.shift = 0;
+            symbol.bias = starts[s] + ProbabilityTotal - 1;
+        } else {
+            uint32_t shift = 0;
+            while (frequency > (1u << shift)) {
+                ++shift;
+            }
+            symbol.reciprocal = static_cast<uint32_t>(((1ULL << (shift + 31)) + frequency - 1) / frequency);
+            symbol.shift = shift - 1;
+            symbol.bias = starts[s];
+        }
+    }
+
+    // rANS : les symboles sont codés à rebours, le décodeur les relit dans
+    // l'ordre ; le flux est rempli depuis la fin d'un tampon assez grand
+    // (au plus un mot par symbole, plus les états finaux). La renormalisation
+    // sort au plus un mot et se fait sans branchement : un test imprévisible
+    // par octet coûtait plus que le codage lui-même.
+    size_t capacity = size * 2 + States * 4;
+    std::unique_ptr<uint8_t[]> stream(new uint8_t[capacity]);
+    uint8_t* cursor = stream.get() + capacity;
+    uint32_t states[States] = {LowerBound, LowerBound, LowerBound, LowerBound};
+    auto encode = [&cursor](uint32_t& state, const Symbol& symbol) {
+        uint32_t renormalize = state >= symbol.limit;
+        cursor[-2] = static_cast<uint8_t>(state);
+        cursor[-1] = static_cast<uint8_t>(state >> 8);
+        cursor -= 2 * renormalize;
+        state >>= 16 * renormalize;
+        uint32_t quotient = static_cast<uint32_t>((static_cast<uint64_t>(state) * symbol.reciprocal) >> 32) >> symbol.shift;
+        state += symbol.bias + quotient * symbol.complement;
+    };
+    size_t i = size;
+    while (i % States != 0) {
+        --i;
+        encode(states[i % States], symbols[data[i]]);
+    }
+    // Quatre états indépendants : leurs calculs se recouvrent
+    while (i > 0) {
+        i -= States;
+        encode(states[3], symbols[data[i + 3]]);
+        encode(states[2], symbols[data[i + 2]]);
+        encode(states[1], symbols[data[i + 1]]);
+        encode(states[0], symbols[data[i]]);
+    }
+    for (int s = States - 1; s >= 0; --s) {
+        cursor -= 4;
+        for (int byte = 0; byte < 4; ++byte) {
+            cursor[byte] = static_cast<uint8_t>(states[s] >> (8 * byte));
+        }
+    }
+    out.insert(out.end(), cursor, stream.get() + capacity);
+    return out;
+}
+
+bool decompress(const uint8_t* data, size_t size, size_t rawSize, std::vector<uint8_t>& out) {
+    out.resize(rawSize);
+    if (rawSize == 0) {
+        return size == 0;
+    }
+    uint32_t frequencies[256];
+    uint32_t starts[256];
+    size_t pos = 0;
+    if (!readTable(data, size, pos, frequencies) || size - pos < States * 4) {
+        return false;
+    }
+    uint8_t symbols[ProbabilityTotal];
+    for (uint32_t s = 0, start = 0; s < 256; ++s) {
+        starts[s] = start;
+        std::fill(symbols + start, symbols + start + frequencies[s], static_cast<uint8_t>(s));
+        start += frequencies[s];
+    }
+
+    uint32_t states[States];
+    for (uint32_t& state : states) {
+        state = 0;
+        for (int byte = 0; byte < 4; ++byte) {
+            state |= static_cast<uint32_t>(data[pos++]) << (8 * byte);
+        }
+        if (state < LowerBound || state >= (LowerBound << 16)) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < rawSize; ++i) {
+        uint32_t& state = states[i % States];
+        uint32_t slot = state & (ProbabilityTotal - 1);
+        uint8_t symbol = symbols[slot];
+        out[i] = symbol;
+        state = frequencies[symbol] * (state >> ProbabilityBits) + slot - starts[symbol];
+        if (state < LowerBound) {
+            if (size - pos < 2) {
+                return false;
+            }
+            state = (state << 16) | data[pos] | static_cast<uint32_t>(data[pos + 1]) << 8;
+            pos += 2;
+        }
+    }
+    // Un flux intact se termine exactement sur les états initiaux du codeur
+    for (uint32_t state : states) {
+        if (state != LowerBound) {
+            return false;
+        }
+    }
+    return pos == size;
+}
+
+}
+}
@@ -0,0 +1,23 @@
+// EntropyCoder.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace GameOfLife {
+
+// Codage entropique d'un flux d'octets (rANS d'ordre 0, quatre états
+// entrelacés, renormalisation par mots de 16 bits) : les fréquences des
+// octets, ramenées à 2^12, sont stockées en tête du flux compressé. Les deltas,
+// faits surtout de zéros et de petits entiers, s'y réduisent fortement, et le
+// décodage ne coûte que quelques opérations par octet.
+namespace EntropyCoder {
+
+std::vector<uint8_t> compress(const uint8_t* data, size_t size);
+
+// rawSize : taille exacte des données d'origine
+bool decompress(const uint8_t* data, size_t size, size_t rawSize, std::vector<uint8_t>& out);
+
+}
+
+}
@@ -1,16 +1,27 @@
 // Game.cpp
 #include "services/Game.h"
+#include "services/BinarySave.h"
+#include "services/MacrocellFormat.h"
+#include "services/RleFormat.h"
+#include "services/TextSave.h"
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <iostream>
+#include <memory>
 
 namespace GameOfLife {
 
 Game::Game(int width, int height, int maxIterations)
     : currentGrid(width, height), previousGrid(width, height),
-      state(Edition), iterations(0), maxIterations(maxIterations) {
+      state(Edition), iterations(0), maxIterations(maxIterations),
+      historyEnabled(true), cursor(Timeline::npos), cursorRevision(0), liveParent(Timeline::npos),
+      patternRevision(0), patternGeneration(0), viewportX(0), viewportY(0), snapshotInterval(0), snapshotFailed(false),
+      replaying(false), replayRevision(0) {
 }
 
 Game::~Game() {
+    stopRecording();
     clearHistory();
 }
 
@@ -19,43 +30,226 @@ Grid& Game::getGrid() {
 }
 
 void Game::saveState() {
-    history.push(currentGrid);
-    // Lorsque nous avançons, nous vidons la pile de redo
-    while (!redoHistory.empty()) {
-        redoHistory.pop();
+    // Une grille modifiée depuis le dernier enregistrement devient un nouveau nœud :
+    // après un undo, elle ouvre une branche au lieu d'effacer le futur exploré
+    if (historyEnabled && isDirty()) {
+        cursor = timeline.addChild(liveParent, currentGrid);
+        cursorRevision = currentGrid.getRevision();
+        liveParent = timeline.parentOf(cursor);
     }
 }
 
+void Game::step() {
+    advance(nullptr, nullptr);
+}
+
+void Game::step(int& created, int& destroyed) {
+    advance(&created, &destroyed);
+}
+
+void Game::advance(int* createdOut, int* destroyedOut) {
+    bool sampled = metrics.wants(iterations + 1);
+    bool counted = sampled || createdOut != nullptr;
+    uint64_t previousRevision = currentGrid.getRevision();
+    int created = 0;
+    int destroyed = 0;
+    std::chrono::steady_clock::time_point start;
+    if (sampled) {
+        start = std::chrono::steady_clock::now();
+    }
+
+    saveState();
+    // Une grille modifiée (édition, undo) met fin à la relecture
+    replaying = replaying && currentGrid.getRevision() == replayRevision;
+    uint64_t generation = 0;
+    if (replaying) {
+        // Image relue : les changements sont comptés sur les seules tuiles non partagées
+        std::unique_ptr<Grid> before(counted ? new Grid(currentGrid) : nullptr);
+        if (replay.next(currentGrid, generation)) {
+            iterations = generation;
+            replayRevision = currentGrid.getRevision();
+        }
+        if (before) {
+            currentGrid.countChanges(*before, created, destroyed);
+        }
+    } else if (counted) {
+        currentGrid.update(created, destroyed);
+        iterations++;
+    } else {
+        currentGrid.update();
+        iterations++;
+    }
+    liveParent = cursor;
+    if (recorder.isRecording()) {
+        recorder.record(currentGrid, iterations);
+    }
+    if (sampled) {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        metrics.record(currentGrid, previousRevision, created, destroyed, iterations, seconds);
+    }
+    if (createdOut != nullptr) {
+        *createdOut = created;
+        *destroyedOut = destroyed;
+    }
+    exportSnapshotIfDue();
+}
+
 void Game::undo() {
-    if (!history.empty()) {
-        redoHistory.push(currentGrid);
-        currentGrid = history.top();
-        history.pop();
+    // Conserver la génération courante pour pouvoir y revenir
+    saveState();
+    size_t parent = timeline.parentOf(cursor);
+    if (parent != Timeline::npos) {
+        moveTo(parent);
     }
 }
 
 void Game::redo() {
-    if (!redoHistory.empty()) {
-        history.push(currentGrid);
-        currentGrid = redoHistory.top();
-        redoHistory.pop();
+    if (!isDirty()) {
+        size_t child = timeline.activeChildOf(cursor);
+        if (child != Timeline::npos) {
+            moveTo(child);
+        }
     }
 }
 
 void Game::clearHistory() {
-    while (!history.empty()) {
-        history.pop();
+    timeline.clear();
+    cursor = Timeline::npos;
+    cursorRevision = 0;
+    liveParent = Timeline::npos;
+}
+
+void Game::setHistoryEnabled(bool enabled) {
+    historyEnabled = enabled;
+    if (!enabled) {
+        clearHistory();
+    }
+}
+
+bool Game::isHistoryEnabled() const {
+    return historyEnabled;
+}
+
+void Game::setHistoryBudget(size_t bytes) {
+    timeline.setMemoryBudget(bytes);
+}
+
+size_t Game::getHistoryMemoryUsage() const {
+    return timeline.memoryUsage();
+}
+
+void Game::setHistorySpill(bool enabled) {
+    timeline.setSpillEnabled(enabled);
+}
+
+size_t Game::getHistoryDiskUsage() const {
+    return timeline.spillUsage();
+}
+
+size_t Game::getHistoryLogicalMemoryUsage() const {
+    return timeline.logicalUsage();
+}
+
+size_t Game::getHistoryLogicalDiskUsage() const {
+    return timeline.spillLogicalUsage();
+}
+
+TileStore& Game::getTileStore() {
+    return timeline.tileStore();
+}
+
+void Game::seek(size_t generation) {
+    saveState();
+    generation = std::max(generation, getTimelineBegin());
+    generation = std::min(generation, getTimelineEnd() - 1);
+
+    // Suivre le chemin actif : ancêtre ou descendant du nœud courant
+    size_t target = cursor;
+    if (generation <= timeline.depthOf(cursor)) {
+        target = timeline.ancestorAt(cursor, generation);
+    } else {
+        for (size_t depth = timeline.depthOf(cursor); depth < generation; ++depth) {
+            target = timeline.activeChildOf(target);
+        }
+    }
+    if (target != cursor) {
+        moveTo(target);
+    }
+}
+
+size_t Game::getTimelineBegin() const {
+    return timeline.empty() ? getTimelinePosition() : timeline.depthOf(timeline.root());
+}
+
+size_t Game::getTimelineEnd() const {
+    if (isDirty()) {
+        return getTimelinePosition() + 1;
+    }
+    return timeline.depthOf(timeline.tipOf(cursor)) + 1;
+}
+
+size_t Game::getTimelinePosition() const {
+    if (isDirty()) {
+        return liveParent == Timeline::npos ? 0 : timeline.depthOf(liveParent) + 1;
+    }
+    return timeline.depthOf(cursor);
+}
+
+int Game::getBranchCount() const {
+    // Une grille non enregistrée n'a pas encore d'alternative
+    if (isDirty()) {
+        return 1;
+    }
+    return static_cast<int>(timeline.childrenOf(timeline.parentOf(cursor)).size());
+}
+
+int Game::getBranchIndex() const {
+    if (isDirty()) {
+        return 0;
     }
-    while (!redoHistory.empty()) {
-        redoHistory.pop();
+    const std::vector<size_t>& siblings = timeline.childrenOf(timeline.parentOf(cursor));
+    for (size_t i = 0; i < siblings.size(); ++i) {
+        if (siblings[i] == cursor) {
+            return static_cast<int>(i);
+        }
     }
+    return 0;
+}
+
+void Game::switchBranch(int offset) {
+    saveState();
+    // Les branches sont les enfants du même parent (les racines pour l'état initial)
+    const std::vector<size_t>& siblings = timeline.childrenOf(timeline.parentOf(cursor));
+    if (siblings.size() < 2) {
+        return;
+    }
+    int count = static_cast<int>(siblings.size());
+    int index = ((getBranchIndex() + offset) % count + count) % count;
+    moveTo(siblings[index]);
+}
+
+bool Game::isDirty() const {
+    return cursor == Timeline::npos || currentGrid.getRevision() != cursorRevision;
 }
 
-int Game::getIterations() const {
+void Game::moveTo(size_t node) {
+    size_t position = getTimelinePosition();
+    // Grille non modifiée depuis le dernier déplacement : les deltas s'appliquent en place
+    size_t from = isDirty() ? Timeline::npos : cursor;
+    if (timeline.load(node, currentGrid, from)) {
+        iterations = iterations + timeline.depthOf(node) - position;
+        cursor = node;
+        cursorRevision = currentGrid.getRevision();
+        liveParent = timeline.parentOf(node);
+        timeline.select(node);
+    }
+}
+
+uint64_t Game::getIterations() const {
     return iterations;
 }
 
-void Game::setIterations(int value) {
+void Game::setIterations(uint64_t value) {
     iterations = value;
 }
 
@@ -83,33 +277,62 @@ void Game::saveToFile(const std::string& filename) const {
     // Ajouter le dossier "save/" au nom de fichier
     std::string fullPath = "saves/" + filename;
 
-    // Ouvrir le fichier pour écrire la sauvegarde
-    std::ofstream file(fullPath);
-    if (!file.is_open()) {
-        std::cerr << "Erreur : Impossible de créer le fichier " << fullPath << std::endl;
-        return;
+    if (saveToPath(fullPath)) {
+        std::cout << "Sauvegarde terminée dans " << fullPath << std::endl;
     }
+}
+
+bool Game::saveToPath(const std::string& path) const {
+    Snapshot snapshot = takeSnapshot();
+    return SaveQueue::writeAtomically(path, [&](const std::string& temporary) {
+        return writeSnapshot(temporary, path, snapshot);
+    });
+}
+
+void Game::saveToFileAsync(const std::string& filename) {
+    Snapshot snapshot = takeSnapshot();
+    saveQueue.submit("saves/" + filename, [filename, snapshot](const std::string& path) {
+        return writeSnapshot(path, filename, snapshot);
+    });
+}
 
-    // Accéder à la grille actuelle
-    const Grid& grid = currentGrid;
+bool Game::pollSaveResult(SaveQueue::Result& result) {
+    return saveQueue.poll(result);
+}
 
-    // Écrire la taille de la grille
-    file << grid.getHeight() << " " << grid.getWidth() << "\n";
+bool Game::isSaving() const {
+    return saveQueue.busy();
+}
+
+Game::Snapshot Game::takeSnapshot() const {
+    bool unchangedPattern = pattern && currentGrid.getRevision() == patternRevision;
+    return Snapshot{currentGrid, iterations, unchangedPattern ? pattern : nullptr};
+}
 
-    // Écrire l'état de chaque cellule (1 pour vivante, 0 pour morte)
-    for (int y = 0; y < grid.getHeight(); ++y) {
-        for (int x = 0; x < grid.getWidth(); ++x) {
-            Cell* cell = grid.getCell(x, y);
-            file << (cell->isAlive() ? "1 " : "0 ");
+bool Game::writeSnapshot(const std::string& path, const std::string& filename, const Snapshot& snapshot) {
+    if (hasExtension(filename, BinarySave::Extension)) {
+        return BinarySave::write(path, snapshot.grid, snapshot.generation);
+    }
+    if (hasExtension(filename, RleFormat::Extension)) {
+        return RleFormat::write(path, snapshot.grid);
+    }
+    if (hasExtension(filename, MacrocellFormat::Extension)) {
+        // Motif chargé et non modifié : l'arbre est réécrit sans être déplié
+        if (snapshot.pattern) {
+            return MacrocellFormat::write(path, *snapshot.pattern, snapshot.grid.getRuleString(), snapshot.generation);
         }
-        file << "\n"; // Nouvelle ligne après chaque rangée
+        Quadtree tree;
+        tree.build(snapshot.grid);
+        return MacrocellFormat::write(path, tree, snapshot.grid.getRuleString(), snapshot.generation);
     }
-
-    file.close();
-    std::cout << "Sauvegarde terminée dans " << fullPath << std::endl;
+    if (hasExtension(filename, Recording::Extension)) {
+        Recorder single;
+        return single.start(path, snapshot.grid, snapshot.generation) && single.stop();
+    }
+    return TextSave::write(path, snapshot.grid);
 }
 
-void Game::loadFromFile(const std::string& filename) {
+bool Game::loadFromFile(const std::string& filename) {
     // Ajouter le dossier "save/" uniquement si ce n'est pas déjà inclus dans le chemin du fichier
     std::string saveDirectory = "saves/";
     std::string fullPath = filename;
@@ -117,38 +340,203 @@ void Game::loadFromFile(const std::string& filename) {
     if (filename.find(saveDirectory) == std::string::npos) {
         fullPath = saveDirectory + filename;
     }
+    return loadFromPath(fullPath);
+}
+
+bool Game::loadFromPath(const std::string& fullPath) {
+    // Les dimensions d'un enregistrement sont fixes : tout chargement y met fin
+    stopRecording();
+    replaying = false;
+
+    if (hasExtension(fullPath, BinarySave::Extension)) {
+        uint64_t generation = 0;
+        if (!BinarySave::read(fullPath, currentGrid, generation)) {
+            return false;
+        }
+        iterations = generation;
+        pattern.reset();  // La grille ne montre plus le motif .mc précédent : il est libéré
+        std::cout << "Chargement terminé depuis " << fullPath << std::endl;
+        return true;
+    }
+    if (hasExtension(fullPath, Recording::Extension)) {
+        uint64_t generation = 0;
+        if (!replay.open(fullPath) || !replay.next(currentGrid, generation)) {
+            return false;
+        }
+        iterations = generation;
+        replaying = true;
+        replayRevision = currentGrid.getRevision();
+        pattern.reset();
+        std::cout << "Relecture de " << fullPath << " (" << replay.getFrameCount() << " générations)" << std::endl;
+        return true;
+    }
+    if (hasExtension(fullPath, RleFormat::Extension)) {
+        // Un motif plus petit que la grille courante y est centré
+        if (!RleFormat::read(fullPath, currentGrid, currentGrid.getWidth(), currentGrid.getHeight())) {
+            return false;
+        }
+        pattern.reset();
+        std::cout << "Chargement terminé depuis " << fullPath << std::endl;
+        return true;
+    }
+    if (hasExtension(fullPath, MacrocellFormat::Extension)) {
+        uint16_t birth, survival;
+        uint64_t generation = 0;
+        auto loaded = std::make_shared<Quadtree>();
+        if (!MacrocellFormat::read(fullPath, *loaded, birth, survival, generation)) {
+            return false;
+        }
+        pattern = loaded;
+        currentGrid.setRule(birth, survival);
+        patternGeneration = generation;
+        // Fenêtre de la taille de la grille courante, centrée sur le motif
+        int64_t half = (int64_t(1) << pattern->getRootLevel()) / 2;
+        setPatternViewport(half - currentGrid.getWidth() / 2, half - currentGrid.getHeight() / 2);
+        std::cout << "Chargement terminé depuis " << fullPath << std::endl;
+        return true;
+    }
+
+    if (!TextSave::read(fullPath, currentGrid)) {
+        return false;
+    }
+    pattern.reset();
+    std::cout << "Chargement terminé depuis " << fullPath << std::endl;
+    return true;
+}
+
+bool Game::isSaveFile(const std::string& filename) {
+    return hasExtension(filename, TextSave::Extension) || hasExtension(filename, BinarySave::Extension) ||
+           hasExtension(filename, RleFormat::Extension) || hasExtension(filename, MacrocellFormat::Extension) ||
+           hasExtension(filename, Recording::Extension);
+}
+
+bool Game::startRecording(const std::string& filename) {
+    std::string fullPath = "saves/" + filename;
+    if (!recorder.start(fullPath, currentGrid, iterations)) {
+        return false;
+    }
+    std::cout << "Enregistrement dans " << fullPath << std::endl;
+    return true;
+}
+
+void Game::stopRecording() {
+    if (!recorder.isRecording()) {
+        return;
+    }
+    uint64_t frames = recorder.getFrameCount();
+    if (recorder.stop()) {
+        std::cout << "Enregistrement terminé : " << frames << " générations dans " << recorder.getPath() << std::endl;
+    }
+}
+
+bool Game::isRecording() const {
+    return recorder.isRecording();
+}
+
+uint64_t Game::getRecordedFrames() const {
+    return recorder.getFrameCount();
+}
 
-    // Ouvrir le fichier de sauvegarde
-    std::ifstream inFile(fullPath);
-    if (!inFile) {
-        std::cerr << "Erreur lors de l'ouverture du fichier de sauvegarde " << fullPath << std::endl;
+void Game::startSnapshots(const std::string& prefix, const std::string& extension, uint64_t interval,
+                          size_t maxPending, SaveQueue::Overflow overflow) {
+    stopSnapshots();
+    snapshotPrefix = prefix;
+    snapshotExtension = extension;
+    snapshotInterval = interval;
+    snapshotFailed = false;
+    snapshotQueue.setLimit(maxPending, overflow);
+}
+
+bool Game::stopSnapshots() {
+    if (snapshotInterval == 0) {
+        return true;
+    }
+    snapshotQueue.wait();
+    collectSnapshotResults();
+    snapshotInterval = 0;
+    return !snapshotFailed;
+}
+
+void Game::exportSnapshotIfDue() {
+    if (snapshotInterval == 0 || iterations % snapshotInterval != 0) {
         return;
     }
+    collectSnapshotResults();
 
-    // Lecture des dimensions de la grille
-    int width, height;
-    inFile >> height >> width;
+    std::string number = std::to_string(iterations);
+    std::string path = snapshotPrefix + "_" + std::string(number.size() < 8 ? 8 - number.size() : 0, '0') +
+                       number + snapshotExtension;
+    Snapshot snapshot = takeSnapshot();
+    snapshotQueue.submit(path, [path, snapshot](const std::string& temporary) {
+        return writeSnapshot(temporary, path, snapshot);
+    });
+}
 
-    // Créer une nouvelle grille avec les dimensions lues
-    currentGrid = Grid(width, height);
+uint64_t Game::getDroppedSnapshots() const {
+    return snapshotQueue.getDropped();
+}
 
-    // Lire l'état de chaque cellule (1 pour vivante, 0 pour morte)
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            int cellState;
-            inFile >> cellState;
-            if (cellState == 1) {
-                currentGrid.setCell(x, y, new AliveCell());
-            } else {
-                currentGrid.setCell(x, y, new DeadCell());
-            }
+// Résultats des écritures terminées, pour ne pas les accumuler
+void Game::collectSnapshotResults() {
+    SaveQueue::Result result;
+    while (snapshotQueue.poll(result)) {
+        if (!result.success) {
+            std::cerr << "Erreur : impossible d'écrire " << result.path << std::endl;
+            snapshotFailed = true;
         }
     }
+}
 
-    inFile.close();
-    std::cout << "Chargement terminé depuis " << fullPath << std::endl;
+bool Game::startMetrics(const std::string& path, uint64_t interval) {
+    return metrics.start(path, interval);
+}
+
+bool Game::stopMetrics() {
+    return metrics.stop();
+}
+
+bool Game::isEmittingMetrics() const {
+    return metrics.isRunning();
 }
 
+bool Game::isReplaying() const {
+    return replaying && currentGrid.getRevision() == replayRevision;
+}
 
+uint64_t Game::getReplayPosition() const {
+    return replay.getPosition();
+}
+
+uint64_t Game::getReplayLength() const {
+    return replay.getFrameCount();
+}
+
+bool Game::hasPattern() const {
+    return pattern != nullptr;
+}
+
+void Game::setPatternViewport(int64_t x, int64_t y) {
+    if (!pattern) {
+        return;
+    }
+    viewportX = x;
+    viewportY = y;
+    pattern->flatten(currentGrid, x, y);
+    patternRevision = currentGrid.getRevision();
+    iterations = patternGeneration;
+}
+
+int64_t Game::getPatternViewportX() const {
+    return viewportX;
+}
+
+int64_t Game::getPatternViewportY() const {
+    return viewportY;
+}
+
+bool Game::hasExtension(const std::string& filename, const std::string& extension) {
+    return filename.size() >= extension.size() &&
+           filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0;
+}
 
 }
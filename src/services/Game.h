@@ -1,7 +1,11 @@
 // Game.h
 #pragma once
 #include "components/Grid.h"
-#include <stack>
+#include "components/Quadtree.h"
+#include "services/MetricsStream.h"
+#include "services/Recording.h"
+#include "services/SaveQueue.h"
+#include "services/Timeline.h"
 #include <string>
 #include <fstream>  // Pour manipuler les fichiers
 
@@ -16,15 +20,48 @@ public:
 
     Grid& getGrid();
     void saveState();
+    void step();    // Enregistre l'état courant puis calcule la génération suivante
+    // Même calcul, en comptant les cellules nées et mortes au passage
+    // (sans seconde comparaison des grilles)
+    void step(int& created, int& destroyed);
     void undo();
     void redo();
     void clearHistory();
 
+    // Sans historique, step() n'enregistre aucune génération (mode console,
+    // mode batch) ; le désactiver efface l'historique existant
+    void setHistoryEnabled(bool enabled);
+    bool isHistoryEnabled() const;
+
+    // Budget mémoire (en octets) de l'historique
+    void setHistoryBudget(size_t bytes);
+    size_t getHistoryMemoryUsage() const;
+
+    // Au-delà du budget, l'historique ancien est déchargé sur disque
+    void setHistorySpill(bool enabled);
+    size_t getHistoryDiskUsage() const;
+
+    // Tailles avant déduplication des tuiles identiques
+    size_t getHistoryLogicalMemoryUsage() const;
+    size_t getHistoryLogicalDiskUsage() const;
+    TileStore& getTileStore();
+
+    // Accès direct à une génération enregistrée (barre de défilement)
+    void seek(size_t generation);
+    size_t getTimelineBegin() const;
+    size_t getTimelineEnd() const;      // Génération courante incluse
+    size_t getTimelinePosition() const;
+
+    // Branches alternatives de la génération courante
+    int getBranchCount() const;
+    int getBranchIndex() const;
+    void switchBranch(int offset);
+
     GameState state;
 
     // Méthodes d'accès
-    int getIterations() const;
-    void setIterations(int value);
+    uint64_t getIterations() const;
+    void setIterations(uint64_t value);
 
     int getMaxIterations() const;
     void setMaxIterations(int value);
@@ -34,20 +71,112 @@ public:
     const Grid& getPreviousGrid() const;
     void setPreviousGrid(const Grid& grid);
 
+    // Le format dépend de l'extension : .txt (texte), .golb (binaire),
+    // .rle ou .mc (motifs), .golr (enregistrement d'une seule image)
     void saveToFile(const std::string& filename) const;
+    // Même écriture à un chemin quelconque, sans message (mode batch)
+    bool saveToPath(const std::string& path) const;
+
+    // Même sauvegarde, écrite par le thread d'entrée/sortie à partir d'un
+    // instantané de la grille (copie des seuls pointeurs de tuiles)
+    void saveToFileAsync(const std::string& filename);
+    bool pollSaveResult(SaveQueue::Result& result);  // Sauvegarde en arrière-plan terminée
+    bool isSaving() const;
     
     // Déclaration de la méthode loadFromFile
-    void loadFromFile(const std::string& filename);
+    // Un enregistrement .golr est relu : step() passe alors à l'image suivante
+    // au lieu de simuler, jusqu'à la fin ou à la première modification de la grille
+    bool loadFromFile(const std::string& filename);  // Faux si le fichier est illisible (grille inchangée)
+    bool loadFromPath(const std::string& path);      // Chemin pris tel quel, hors du dossier saves/
+
+    // Enregistrement de chaque génération calculée par step(), écrit en
+    // arrière-plan ; un chargement y met fin
+    bool startRecording(const std::string& filename);
+    void stopRecording();
+    bool isRecording() const;
+    uint64_t getRecordedFrames() const;
+
+    // Export de l'état toutes les interval générations, vers
+    // prefix_<génération><extension> (format selon l'extension, voir
+    // saveToFile). step() ne fait que remettre un instantané à une file
+    // d'écriture dédiée, bornée à maxPending instantanés en attente.
+    void startSnapshots(const std::string& prefix, const std::string& extension, uint64_t interval,
+                        size_t maxPending, SaveQueue::Overflow overflow);
+    bool stopSnapshots();          // Attend les écritures en attente ; faux si l'une a échoué
+    void exportSnapshotIfDue();    // Appelé par step() ; à appeler après tout autre calcul de génération
+    uint64_t getDroppedSnapshots() const;
+
+    // Statistiques des générations calculées par step(), toutes les interval
+    // générations, écrites en arrière-plan (.csv ou .jsonl, voir MetricsStream)
+    bool startMetrics(const std::string& path, uint64_t interval);
+    bool stopMetrics();  // Faux si une écriture a échoué
+    bool isEmittingMetrics() const;
+
+    bool isReplaying() const;
+    uint64_t getReplayPosition() const;
+    uint64_t getReplayLength() const;
+
+    // Extension reconnue par loadFromFile (listes de sauvegardes)
+    static bool isSaveFile(const std::string& filename);
+
+    // Motif .mc chargé : la grille n'en montre qu'une fenêtre, dont le coin
+    // supérieur gauche est (x, y) dans le motif. Déplacer la fenêtre remplace
+    // le contenu de la grille par cette zone du motif, à sa génération de
+    // chargement.
+    bool hasPattern() const;
+    void setPatternViewport(int64_t x, int64_t y);
+    int64_t getPatternViewportX() const;
+    int64_t getPatternViewportY() const;
 
 private:
-    int iterations;
+    uint64_t iterations;
     int maxIterations;
 
     Grid currentGrid;
     Grid previousGrid;
 
-    std::stack<Grid> history;       // Pile pour l'historique des grilles (undo)
-    std::stack<Grid> redoHistory;   // Pile pour les grilles annulées (redo)
+    Timeline timeline;       // Arbre des grilles enregistrées (undo/redo/branches)
+    bool historyEnabled;     // Faux : step() n'enregistre rien
+    size_t cursor;           // Dernier nœud enregistré ou chargé dans currentGrid
+    uint64_t cursorRevision; // Révision de currentGrid à ce moment
+    size_t liveParent;       // Parent d'un futur enregistrement de currentGrid
+
+    std::shared_ptr<const Quadtree> pattern;  // Dernier motif .mc chargé, jamais déplié en entier
+    uint64_t patternRevision;    // Révision de currentGrid juste après le dépliage
+    uint64_t patternGeneration;  // Génération enregistrée dans le motif
+    int64_t viewportX;
+    int64_t viewportY;
+
+    SaveQueue saveQueue;
+
+    SaveQueue snapshotQueue;
+    std::string snapshotPrefix;
+    std::string snapshotExtension;
+    uint64_t snapshotInterval;  // 0 : pas d'export
+    bool snapshotFailed;
+
+    MetricsStream metrics;
+    Recorder recorder;
+    RecordingPlayer replay;
+    bool replaying;
+    uint64_t replayRevision;  // Révision de currentGrid après la dernière image relue
+
+    // État figé au moment de la demande de sauvegarde
+    struct Snapshot {
+        Grid grid;
+        uint64_t generation;
+        std::shared_ptr<const Quadtree> pattern;  // Nul si la grille a changé depuis le dépliage
+    };
+
+    bool isDirty() const;
+    void collectSnapshotResults();
+    void advance(int* created, int* destroyed);  // Comptes non demandés si nuls
+    void moveTo(size_t node);
+
+    Snapshot takeSnapshot() const;
+    static bool writeSnapshot(const std::string& path, const std::string& filename, const Snapshot& snapshot);
+
+    static bool hasExtension(const std::string& filename, const std::string& extension);
 };
 
 }
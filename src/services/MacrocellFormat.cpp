@@ -0,0 +1,244 @@
+// MacrocellFormat.cpp
+#include "services/MacrocellFormat.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace GameOfLife {
+namespace MacrocellFormat {
+
+namespace {
+
+const size_t BufferSize = 1 << 20;
+
+bool fail(const std::string& path, size_t line, const std::string& message) {
+    std::cerr << "Erreur Macrocell (" << path << ", ligne " << line << ") : " << message << std::endl;
+    return false;
+}
+
+// Lit au plus max entiers séparés par des espaces ; faux si la ligne contient autre chose
+bool parseNumbers(const std::string& line, uint64_t* values, int max, int& count) {
+    const char* p = line.c_str();
+    count = 0;
+    while (true) {
+        while (*p == ' ' || *p == '\t' || *p == '\r') {
+            ++p;
+        }
+        if (*p == '\0') {
+            return true;
+        }
+        if (*p < '0' || *p > '9' || count == max) {
+            return false;
+        }
+        char* end = nullptr;
+        values[count++] = std::strtoull(p, &end, 10);
+        p = end;
+    }
+}
+
+void writeLeaf(std::string& out, uint64_t bits) {
+    // Les cellules mortes en fin de ligne et les lignes vides finales sont implicites
+    int lastRow = 7;
+    while (lastRow > 0 && ((bits >> (8 * lastRow)) & 0xFF) == 0) {
+        --lastRow;
+    }
+    for (int r = 0; r <= lastRow; ++r) {
+        uint64_t row = (bits >> (8 * r)) & 0xFF;
+        for (int x = 0; row >> x; ++x) {
+            out += ((row >> x) & 1) ? '*' : '.';
+        }
+        out += '$';
+    }
+    out += '\n';
+}
+
+// Numérotation en ordre postfixe : un nœud est écrit après ses enfants
+class Writer {
+public:
+    Writer(const Quadtree& tree, std::ofstream& file)
+        : tree(tree), file(file), fileIds(tree.nodeCount() + 1, 0), written(0) {
+    }
+
+    uint32_t emit(uint32_t id) {
+        if (id == Quadtree::Empty || fileIds[id] != 0) {
+            return fileIds[id];
+        }
+        if (tree.levelOf(id) == Quadtree::LeafLevel) {
+            writeLeaf(buffer, tree.leafBits(id));
+        } else {
+            const uint32_t* children = tree.childrenOf(id);
+            uint32_t ids[4];
+            for (int i = 0; i < 4; ++i) {
+                ids[i] = emit(children[i]);
+            }
+            buffer += std::to_string(tree.levelOf(id));
+            for (uint32_t child : ids) {
+                buffer += ' ';
+                buffer += std::to_string(child);
+            }
+            buffer += '\n';
+        }
+        if (buffer.size() >= BufferSize) {
+            flush();
+        }
+        fileIds[id] = ++written;
+        return written;
+    }
+
+    // Nœud supplémentaire écrit après les autres (racine artificielle)
+    void emitNode(int level, uint32_t nw) {
+        buffer += std::to_string(level) + " " + std::to_string(nw) + " 0 0 0\n";
+    }
+
+    void flush() {
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+
+private:
+    const Quadtree& tree;
+    std::ofstream& file;
+    std::vector<uint32_t> fileIds;  // Numéro de ligne (à partir de 1) par nœud de l'arbre
+    uint32_t written;
+    std::string buffer;
+};
+
+}
+
+bool write(const std::string& path, const Quadtree& tree, const std::string& rule, uint64_t generation) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Erreur : Impossible de créer le fichier " << path << std::endl;
+        return false;
+    }
+    file << "[M2] (Jeu de la vie)\n#R " << rule << "\n#G " << generation << "\n";
+
+    Writer writer(tree, file);
+    uint32_t root = writer.emit(tree.getRoot());
+    // La racine doit être un nœud : une feuille seule ou un motif vide est enveloppé
+    if (tree.getRoot() == Quadtree::Empty || tree.getRootLevel() == Quadtree::LeafLevel) {
+        writer.emitNode(Quadtree::LeafLevel + 1, root);
+    }
+    writer.flush();
+
+    if (!file) {
+        std::cerr << "Erreur : écriture incomplète de " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool read(const std::string& path, Quadtree& tree, uint16_t& birth, uint16_t& survival, uint64_t& generation) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Erreur lors de l'ouverture du fichier de sauvegarde " << path << std::endl;
+        return false;
+    }
+    std::vector<char> streamBuffer(BufferSize);
+    file.rdbuf()->pubsetbuf(streamBuffer.data(), static_cast<std::streamsize>(streamBuffer.size()));
+
+    std::string line;
+    size_t lineNumber = 1;
+    if (!std::getline(file, line) || line.compare(0, 4, "[M2]") != 0) {
+        return fail(path, lineNumber, "en-tête \"[M2]\" manquant");
+    }
+
+    Quadtree loaded;
+    uint16_t ruleBirth = Grid::ConwayBirth;
+    uint16_t ruleSurvival = Grid::ConwaySurvival;
+    uint64_t ruleGeneration = 0;
+
+    // Indice = numéro de ligne du fichier (0 : vide) ; niveau gardé à part
+    // car une feuille ou un nœud vide devient l'identifiant Empty
+    std::vector<uint32_t> ids(1, Quadtree::Empty);
+    std::vector<int> levels(1, -1);
+
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty()) {
+            continue;
+        }
+
+        if (line[0] == '#') {
+            if (line.compare(0, 3, "#R ") == 0) {
+                std::string rule = line.substr(3);
+                size_t colon = rule.find(':');
+                if (colon != std::string::npos) {
+                    rule = rule.substr(0, colon);
+                }
+                if (!Grid::parseRule(rule, ruleBirth, ruleSurvival)) {
+                    return fail(path, lineNumber, "règle non reconnue \"" + rule + "\"");
+                }
+            } else if (line.compare(0, 3, "#G ") == 0) {
+                ruleGeneration = std::strtoull(line.c_str() + 3, nullptr, 10);
+            }
+            continue;
+        }
+
+        if (line[0] == '.' || line[0] == '*' || line[0] == '$') {
+            uint64_t bits = 0;
+            int x = 0, y = 0;
+            for (char c : line) {
+                if (c == '$') {
+                    ++y;
+                    x = 0;
+                } else if (c == '.' || c == '*') {
+                    if (x >= 8 || y >= 8) {
+                        return fail(path, lineNumber, "feuille plus grande que 8 x 8");
+                    }
+                    if (c == '*') {
+                        bits |= 1ULL << (y * 8 + x);
+                    }
+                    ++x;
+                } else {
+                    return fail(path, lineNumber, std::string("caractère inattendu '") + c + "'");
+                }
+            }
+            ids.push_back(loaded.leaf(bits));
+            levels.push_back(Quadtree::LeafLevel);
+            continue;
+        }
+
+        uint64_t values[5];
+        int count = 0;
+        if (!parseNumbers(line, values, 5, count) || count != 5) {
+            return fail(path, lineNumber, "ligne de nœud invalide \"" + line + "\"");
+        }
+        if (values[0] <= Quadtree::LeafLevel || values[0] > Quadtree::MaxLevel) {
+            return fail(path, lineNumber, "niveau " + std::to_string(values[0]) +
+                                          " non pris en charge (règles à deux états uniquement)");
+        }
+        int level = static_cast<int>(values[0]);
+        uint32_t children[4];
+        for (int i = 0; i < 4; ++i) {
+            uint64_t child = values[i + 1];
+            if (child >= ids.size()) {
+                return fail(path, lineNumber, "référence " + std::to_string(child) + " vers une ligne suivante");
+            }
+            if (child != 0 && levels[child] != level - 1) {
+                return fail(path, lineNumber, "le nœud " + std::to_string(child) +
+                                              " n'est pas de niveau " + std::to_string(level - 1));
+            }
+            children[i] = ids[child];
+        }
+        ids.push_back(loaded.node(level, children[0], children[1], children[2], children[3]));
+        levels.push_back(level);
+    }
+
+    if (ids.size() < 2) {
+        return fail(path, lineNumber, "aucun nœud dans le fichier");
+    }
+    loaded.setRoot(ids.back(), levels.back());
+    tree = std::move(loaded);
+    birth = ruleBirth;
+    survival = ruleSurvival;
+    generation = ruleGeneration;
+    return true;
+}
+
+}
+}
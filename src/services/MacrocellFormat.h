@@ -0,0 +1,28 @@
+// MacrocellFormat.h
+#pragma once
+#include "components/Quadtree.h"
+#include <string>
+
+namespace GameOfLife {
+
+// Motifs au format Macrocell (extension .mc) de Golly : le motif est un
+// arbre quaternaire dont chaque nœud distinct n'est écrit qu'une fois.
+//   [M2] (golly 4.2)
+//   #R B3/S23
+//   #G 0
+//   .*$..*$***$        feuille 8 x 8 ("." morte, "*" vivante, "$" fin de ligne)
+//   4 1 0 0 0          nœud : niveau, puis nw ne sw se (numéros de ligne, 0 = vide)
+// La dernière ligne de nœud est la racine. Le fichier est lu et écrit sans
+// jamais déplier l'arbre : sa durée dépend de la taille compressée du motif.
+namespace MacrocellFormat {
+
+const char Extension[] = ".mc";
+
+bool write(const std::string& path, const Quadtree& tree, const std::string& rule, uint64_t generation);
+
+// Remplace le contenu de tree ; birth et survival reçoivent la règle (#R)
+bool read(const std::string& path, Quadtree& tree, uint16_t& birth, uint16_t& survival, uint64_t& generation);
+
+}
+
+}
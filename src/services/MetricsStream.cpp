@@ -0,0 +1,132 @@
+// MetricsStream.cpp
+#include "services/MetricsStream.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+namespace GameOfLife {
+
+namespace {
+
+const size_t FlushSize = 64 * 1024;  // Écriture par blocs d'au moins 64 Kio
+const auto IdlePeriod = std::chrono::milliseconds(5);
+
+bool isJsonPath(const std::string& path) {
+    const std::string extension = ".jsonl";
+    return path.size() >= extension.size() &&
+           path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+}
+
+MetricsStream::MetricsStream()
+    : queue(QueueCapacity), running(false), interval(1), dropped(0), lastRevision(0), lastPopulation(0),
+      json(false), stopping(false), failed(false) {
+}
+
+MetricsStream::~MetricsStream() {
+    stop();
+}
+
+bool MetricsStream::start(const std::string& path, uint64_t interval) {
+    stop();
+    file.open(path, std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Erreur : Impossible de créer le fichier " << path << std::endl;
+        return false;
+    }
+    json = isJsonPath(path);
+    if (!json) {
+        file << "generation,population,naissances,morts,tuiles_modifiees,duree_calcul_us\n";
+    }
+    this->interval = interval == 0 ? 1 : interval;
+    running = true;
+    dropped = 0;
+    lastRevision = 0;
+    stopping = false;
+    failed = false;
+    writer = std::thread(&MetricsStream::run, this);
+    return true;
+}
+
+bool MetricsStream::stop() {
+    if (!running) {
+        return true;
+    }
+    stopping.store(true, std::memory_order_release);
+    writer.join();
+    running = false;
+    if (dropped != 0) {
+        std::cerr << "Attention : " << dropped << " relevés perdus (écriture trop lente)" << std::endl;
+    }
+    if (failed) {
+        std::cerr << "Erreur : écriture incomplète des statistiques" << std::endl;
+    }
+    return !failed;
+}
+
+void MetricsStream::record(const Grid& grid, uint64_t previousRevision, int created, int destroyed,
+                           uint64_t generation, double stepSeconds) {
+    uint64_t population = previousRevision == lastRevision
+        ? lastPopulation + created - destroyed
+        : static_cast<uint64_t>(grid.countAlive());
+    lastRevision = grid.getRevision();
+    lastPopulation = population;
+
+    Sample sample{generation, population, static_cast<uint64_t>(created), static_cast<uint64_t>(destroyed),
+                  static_cast<uint64_t>(grid.countChangedTiles()), stepSeconds};
+    if (!queue.push(sample)) {
+        ++dropped;
+    }
+}
+
+void MetricsStream::run() {
+    std::string buffer;
+    buffer.reserve(FlushSize * 2);
+    bool pending = false;  // Données écrites mais pas encore vidées vers le disque
+    while (true) {
+        // Après la demande d'arrêt, un dernier passage vide la file
+        bool finishing = stopping.load(std::memory_order_acquire);
+        Sample sample;
+        while (queue.pop(sample)) {
+            format(sample, buffer);
+            if (buffer.size() >= FlushSize) {
+                file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                buffer.clear();
+                pending = true;
+            }
+        }
+        if (finishing) {
+            break;
+        }
+        // File vide : ce qui est prêt est rendu visible aux lecteurs du fichier
+        if (!buffer.empty() || pending) {
+            file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            file.flush();
+            buffer.clear();
+            pending = false;
+        }
+        std::this_thread::sleep_for(IdlePeriod);
+    }
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    file.close();
+    failed = file.fail();
+}
+
+void MetricsStream::format(const Sample& sample, std::string& buffer) const {
+    char line[256];
+    const char* pattern = json
+        ? "{\"generation\":%llu,\"population\":%llu,\"naissances\":%llu,\"morts\":%llu,"
+          "\"tuiles_modifiees\":%llu,\"duree_calcul_us\":%.3f}\n"
+        : "%llu,%llu,%llu,%llu,%llu,%.3f\n";
+    int length = std::snprintf(line, sizeof(line), pattern,
+                               static_cast<unsigned long long>(sample.generation),
+                               static_cast<unsigned long long>(sample.population),
+                               static_cast<unsigned long long>(sample.births),
+                               static_cast<unsigned long long>(sample.deaths),
+                               static_cast<unsigned long long>(sample.changedTiles),
+                               sample.stepSeconds * 1e6);
+    buffer.append(line, static_cast<size_t>(length));
+}
+
+}
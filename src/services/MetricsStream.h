@@ -0,0 +1,75 @@
+// MetricsStream.h
+#pragma once
+#include "components/Grid.h"
+#include "services/SpscQueue.h"
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+
+namespace GameOfLife {
+
+// Flux de statistiques par génération (population, naissances, morts,
+// tuiles modifiées, durée du calcul), relevées toutes les n générations.
+// Le thread de calcul ne fait que déposer un relevé dans une file sans
+// verrou ; la mise en forme et l'écriture, tamponnées, se font dans un
+// thread d'arrière-plan. Format selon l'extension : .csv (avec en-tête)
+// ou .jsonl (un objet JSON par ligne).
+class MetricsStream {
+public:
+    struct Sample {
+        uint64_t generation;
+        uint64_t population;
+        uint64_t births;
+        uint64_t deaths;
+        uint64_t changedTiles;
+        double stepSeconds;
+    };
+
+    MetricsStream();
+    ~MetricsStream();  // Termine le flux
+
+    MetricsStream(const MetricsStream&) = delete;
+    MetricsStream& operator=(const MetricsStream&) = delete;
+
+    bool start(const std::string& path, uint64_t interval);
+    // Écrit les relevés en attente et ferme le fichier ; faux si une écriture a échoué
+    bool stop();
+
+    bool isRunning() const { return running; }
+    uint64_t getInterval() const { return interval; }
+    uint64_t getDropped() const { return dropped; }  // Relevés perdus, file pleine
+
+    // Vrai si la génération doit être relevée : l'appelant la calcule alors
+    // avec Grid::update(created, destroyed)
+    bool wants(uint64_t generation) const { return running && generation % interval == 0; }
+    // Relevé de la génération calculée ; previousRevision est la révision de
+    // la grille juste avant le calcul
+    void record(const Grid& grid, uint64_t previousRevision, int created, int destroyed,
+                uint64_t generation, double stepSeconds);
+
+private:
+    static const size_t QueueCapacity = 4096;
+
+    SpscQueue<Sample> queue;
+    bool running;
+    uint64_t interval;
+    uint64_t dropped;
+
+    // Population tenue à jour tant que les relevés se suivent sans modification
+    uint64_t lastRevision;
+    uint64_t lastPopulation;
+
+    // État du thread d'écriture
+    std::ofstream file;
+    bool json;
+    std::thread writer;
+    std::atomic<bool> stopping;
+    bool failed;
+
+    void run();
+    void format(const Sample& sample, std::string& buffer) const;
+};
+
+}
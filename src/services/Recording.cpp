@@ -0,0 +1,405 @@
+// Recording.cpp
+#include "services/Recording.h"
+#include "services/DeltaCodec.h"
+#include "services/EntropyCoder.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace GameOfLife {
+
+namespace {
+
+const size_t HeaderSize = 32;
+const size_t ChunkHeaderSize = 24;
+const size_t FooterSize = 12;
+const size_t MaxPending = 256;  // Au-delà, record() attend le thread d'écriture
+const size_t WakeBatch = 16;    // Le thread d'écriture est réveillé par lots d'images
+const uint32_t ToroidalFlag = 1;
+const uint64_t NoFrame = UINT64_MAX;
+
+void put(uint8_t* out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+uint64_t get(const uint8_t* in, int bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) {
+        value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+// Taille maximale d'une image décompressée : génération et taille en
+// varint, puis tous les mots de toutes les tuiles avec leurs positions
+uint64_t maxFrameSize(const Grid& grid) {
+    return 20 + static_cast<uint64_t>(grid.getTileCount()) * (20 + 3 * Grid::TileSize * 9);
+}
+
+bool readAt(std::ifstream& file, uint64_t offset, uint8_t* out, size_t size) {
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(offset));
+    file.read(reinterpret_cast<char*>(out), static_cast<std::streamsize>(size));
+    return static_cast<size_t>(file.gcount()) == size;
+}
+
+}
+
+Recorder::Recorder()
+    : recording(false), frameCount(0), stopping(false), chunkFrames(0), chunkFirstFrame(0),
+      writtenFrames(0), failed(false) {
+}
+
+Recorder::~Recorder() {
+    stop();
+}
+
+bool Recorder::start(const std::string& path, const Grid& grid, uint64_t generation) {
+    stop();
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Erreur : Impossible de créer le fichier " << path << std::endl;
+        return false;
+    }
+
+    uint8_t header[HeaderSize] = {};
+    std::memcpy(header, "GOLR", 4);
+    put(header + 4, Recording::Version, 2);
+    put(header + 6, HeaderSize, 2);
+    put(header + 8, grid.getWidth(), 4);
+    put(header + 12, grid.getHeight(), 4);
+    put(header + 16, grid.getBirthMask(), 2);
+    put(header + 18, grid.getSurvivalMask(), 2);
+    put(header + 20, grid.isToroidal() ? ToroidalFlag : 0, 4);
+    file.write(reinterpret_cast<const char*>(header), HeaderSize);
+
+    this->path = path;
+    recording = true;
+    frameCount = 0;
+    stopping = false;
+    previous.reset();
+    chunk.clear();
+    chunkFrames = 0;
+    writtenFrames = 0;
+    index.clear();
+    failed = !file;
+    writer = std::thread(&Recorder::run, this);
+    record(grid, generation);
+    return true;
+}
+
+void Recorder::record(const Grid& grid, uint64_t generation) {
+    if (!recording) {
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        drained.wait(lock, [this] { return queue.size() < MaxPending; });
+        queue.push_back(Frame{grid, generation});
+        ++frameCount;
+        if (queue.size() < WakeBatch) {
+            return;
+        }
+    }
+    wake.notify_one();
+}
+
+bool Recorder::stop() {
+    if (!recording) {
+        return true;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    writer.join();
+    recording = false;
+    previous.reset();
+    if (failed) {
+        std::cerr << "Erreur : écriture incomplète de " << path << std::endl;
+    }
+    return !failed;
+}
+
+void Recorder::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this] { return stopping || queue.size() >= WakeBatch; });
+        if (queue.empty()) {
+            break;
+        }
+        std::deque<Frame> batch;
+        batch.swap(queue);
+        drained.notify_all();
+        lock.unlock();
+        for (Frame& frame : batch) {
+            encode(frame);
+        }
+        lock.lock();
+    }
+    lock.unlock();
+
+    // Dernier bloc, puis index des blocs et pied de fichier
+    flushChunk();
+    uint64_t indexOffset = static_cast<uint64_t>(file.tellp());
+    std::vector<uint8_t> table(8 + index.size() * 16 + FooterSize);
+    std::memcpy(table.data(), "GOLX", 4);
+    put(table.data() + 4, index.size(), 4);
+    for (size_t i = 0; i < index.size(); ++i) {
+        put(table.data() + 8 + i * 16, index[i].first, 8);
+        put(table.data() + 16 + i * 16, index[i].second, 8);
+    }
+    put(table.data() + table.size() - FooterSize, indexOffset, 8);
+    std::memcpy(table.data() + table.size() - 4, "GOLE", 4);
+    file.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size()));
+    file.close();
+    failed = failed || !file;
+}
+
+void Recorder::encode(Frame& frame) {
+    if (previous && (frame.grid.getWidth() != previous->getWidth() || frame.grid.getHeight() != previous->getHeight())) {
+        failed = true;  // Les dimensions d'un enregistrement sont fixes
+        return;
+    }
+    // Première image d'un bloc : delta depuis une grille vide, soit l'image complète
+    std::vector<uint8_t> delta = chunkFrames == 0
+        ? DeltaCodec::encodeXor(Grid(frame.grid.getWidth(), frame.grid.getHeight()), frame.grid)
+        : DeltaCodec::encodeXor(*previous, frame.grid);
+    if (chunkFrames == 0) {
+        chunkFirstFrame = writtenFrames;
+    }
+    DeltaCodec::writeVarint(chunk, frame.generation);
+    DeltaCodec::writeVarint(chunk, delta.size());
+    chunk.insert(chunk.end(), delta.begin(), delta.end());
+    previous.reset(new Grid(std::move(frame.grid)));
+    ++chunkFrames;
+    ++writtenFrames;
+    if (chunkFrames == Recording::FramesPerChunk) {
+        flushChunk();
+    }
+}
+
+void Recorder::flushChunk() {
+    if (chunkFrames == 0) {
+        return;
+    }
+    std::vector<uint8_t> packed = EntropyCoder::compress(chunk.data(), chunk.size());
+    uint8_t header[ChunkHeaderSize];
+    std::memcpy(header, "GOLC", 4);
+    put(header + 4, chunkFrames, 4);
+    put(header + 8, chunk.size(), 4);
+    put(header + 12, packed.size(), 4);
+    put(header + 16, chunkFirstFrame, 8);
+
+    index.emplace_back(chunkFirstFrame, static_cast<uint64_t>(file.tellp()));
+    file.write(reinterpret_cast<const char*>(header), ChunkHeaderSize);
+    file.write(reinterpret_cast<const char*>(packed.data()), static_cast<std::streamsize>(packed.size()));
+    failed = failed || !file;
+    chunk.clear();
+    chunkFrames = 0;
+}
+
+RecordingPlayer::RecordingPlayer()
+    : fileSize(0), frameCount(0), position(NoFrame), generation(0), loadedChunk(0), rawPos(0) {
+}
+
+bool RecordingPlayer::open(const std::string& path) {
+    this->path = path;
+    file.close();
+    file.clear();
+    file.open(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        std::cerr << "Erreur lors de l'ouverture de l'enregistrement " << path << std::endl;
+        return false;
+    }
+    fileSize = static_cast<uint64_t>(file.tellg());
+    chunks.clear();
+    frameCount = 0;
+    position = NoFrame;
+    if (!readHeader()) {
+        std::cerr << "Erreur : " << path << " n'est pas un enregistrement valide" << std::endl;
+        return false;
+    }
+    // L'index manque si l'enregistrement a été interrompu : les blocs sont alors parcourus
+    if (!readIndex() && !scanChunks()) {
+        std::cerr << "Erreur : aucune image lisible dans " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool RecordingPlayer::readHeader() {
+    uint8_t header[HeaderSize];
+    if (!readAt(file, 0, header, HeaderSize) || std::memcmp(header, "GOLR", 4) != 0 ||
+        get(header + 4, 2) != Recording::Version) {
+        return false;
+    }
+    uint64_t width = get(header + 8, 4);
+    uint64_t height = get(header + 12, 4);
+    if (width == 0 || height == 0 || width > (1u << 30) || height > (1u << 30)) {
+        return false;
+    }
+    current.reset(new Grid(static_cast<int>(width), static_cast<int>(height)));
+    current->setRule(static_cast<uint16_t>(get(header + 16, 2)), static_cast<uint16_t>(get(header + 18, 2)));
+    current->setToroidal((get(header + 20, 4) & ToroidalFlag) != 0);
+    return true;
+}
+
+bool RecordingPlayer::readIndex() {
+    uint8_t footer[FooterSize];
+    if (fileSize < HeaderSize + FooterSize || !readAt(file, fileSize - FooterSize, footer, FooterSize) ||
+        std::memcmp(footer + 8, "GOLE", 4) != 0) {
+        return false;
+    }
+    uint64_t indexOffset = get(footer, 8);
+    uint8_t head[8];
+    if (indexOffset < HeaderSize || indexOffset + 8 > fileSize - FooterSize ||
+        !readAt(file, indexOffset, head, 8) || std::memcmp(head, "GOLX", 4) != 0) {
+        return false;
+    }
+    uint64_t count = get(head + 4, 4);
+    if (count == 0 || count * 16 > fileSize - FooterSize - indexOffset - 8) {
+        return false;
+    }
+    std::vector<uint8_t> table(count * 16);
+    if (!readAt(file, indexOffset + 8, table.data(), table.size())) {
+        return false;
+    }
+    // Blocs contigus entre l'en-tête et l'index, la première image à 0 puis au
+    // plus un bloc d'images plus loin à chaque bloc : seek() en dépend
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t firstFrame = get(table.data() + i * 16, 8);
+        uint64_t offset = get(table.data() + i * 16 + 8, 8);
+        bool valid = i == 0
+            ? firstFrame == 0 && offset == HeaderSize
+            : firstFrame > chunks.back().firstFrame && firstFrame - chunks.back().firstFrame <= Recording::FramesPerChunk &&
+              offset >= chunks.back().offset + ChunkHeaderSize;
+        if (!valid || offset > indexOffset - ChunkHeaderSize) {
+            chunks.clear();
+            return false;
+        }
+        chunks.push_back(Chunk{firstFrame, offset, 0, 0, 0});
+    }
+
+    // Tailles des blocs : lues dans leur en-tête au premier chargement ; il
+    // suffit ici du nombre d'images du dernier bloc
+    if (!readChunkHeader(chunks.back().offset, chunks.back().firstFrame, chunks.back())) {
+        chunks.clear();
+        return false;
+    }
+    frameCount = chunks.back().firstFrame + chunks.back().frames;
+    return true;
+}
+
+bool RecordingPlayer::scanChunks() {
+    chunks.clear();
+    uint64_t offset = HeaderSize;
+    uint64_t frames = 0;
+    Chunk chunk{frames, offset, 0, 0, 0};
+    // Un bloc tronqué ou incohérent termine la lecture
+    while (readChunkHeader(offset, frames, chunk)) {
+        chunks.push_back(chunk);
+        frames += chunk.frames;
+        offset += ChunkHeaderSize + chunk.packedSize;
+        chunk = Chunk{frames, offset, 0, 0, 0};
+    }
+    frameCount = frames;
+    return !chunks.empty();
+}
+
+bool RecordingPlayer::readChunkHeader(uint64_t offset, uint64_t firstFrame, Chunk& chunk) {
+    uint8_t header[ChunkHeaderSize];
+    if (offset > fileSize || fileSize - offset < ChunkHeaderSize || !readAt(file, offset, header, ChunkHeaderSize) ||
+        std::memcmp(header, "GOLC", 4) != 0 || get(header + 16, 8) != firstFrame) {
+        return false;
+    }
+    uint32_t frames = static_cast<uint32_t>(get(header + 4, 4));
+    uint32_t rawSize = static_cast<uint32_t>(get(header + 8, 4));
+    uint32_t packedSize = static_cast<uint32_t>(get(header + 12, 4));
+    // Vérifié avant toute allocation : rien ne doit dépasser le fichier
+    // ni ce qu'un bloc de cette grille peut contenir
+    if (frames == 0 || frames > Recording::FramesPerChunk || packedSize > fileSize - offset - ChunkHeaderSize ||
+        rawSize > frames * maxFrameSize(*current)) {
+        return false;
+    }
+    chunk.frames = frames;
+    chunk.rawSize = rawSize;
+    chunk.packedSize = packedSize;
+    return true;
+}
+
+bool RecordingPlayer::loadChunk(size_t index) {
+    Chunk& chunk = chunks[index];
+    if (!readChunkHeader(chunk.offset, chunk.firstFrame, chunk)) {
+        return false;
+    }
+    // Le nombre d'images doit correspondre à l'index
+    uint64_t end = index + 1 < chunks.size() ? chunks[index + 1].firstFrame : frameCount;
+    if (chunk.firstFrame + chunk.frames != end) {
+        return false;
+    }
+    std::vector<uint8_t> packed(chunk.packedSize);
+    if (!readAt(file, chunk.offset + ChunkHeaderSize, packed.data(), packed.size()) ||
+        !EntropyCoder::decompress(packed.data(), packed.size(), chunk.rawSize, raw)) {
+        return false;
+    }
+
+    // Le bloc commence par une image complète : on repart d'une grille vide
+    Grid empty(current->getWidth(), current->getHeight());
+    empty.setRule(current->getBirthMask(), current->getSurvivalMask());
+    empty.setToroidal(current->isToroidal());
+    *current = std::move(empty);
+    loadedChunk = index;
+    rawPos = 0;
+    position = chunk.firstFrame - 1;  // NoFrame pour le premier bloc
+    return true;
+}
+
+bool RecordingPlayer::applyFrame() {
+    uint64_t frameGeneration, size;
+    if (!DeltaCodec::readVarint(raw, rawPos, frameGeneration) || !DeltaCodec::readVarint(raw, rawPos, size) ||
+        size > raw.size() - rawPos) {
+        return false;
+    }
+    std::vector<uint8_t> delta(raw.begin() + static_cast<std::ptrdiff_t>(rawPos),
+                               raw.begin() + static_cast<std::ptrdiff_t>(rawPos + size));
+    rawPos += size;
+    if (!DeltaCodec::applyXor(delta, *current)) {
+        return false;
+    }
+    generation = frameGeneration;
+    ++position;
+    return true;
+}
+
+bool RecordingPlayer::next(Grid& grid, uint64_t& frameGeneration) {
+    return seek(position + 1, grid, frameGeneration);  // NoFrame + 1 = 0
+}
+
+bool RecordingPlayer::seek(uint64_t frame, Grid& grid, uint64_t& frameGeneration) {
+    if (frame >= frameCount) {
+        return false;
+    }
+    // Bloc contenant l'image ; on n'y repart de l'image complète que pour reculer
+    size_t target = static_cast<size_t>(std::upper_bound(chunks.begin(), chunks.end(), frame,
+        [](uint64_t value, const Chunk& chunk) { return value < chunk.firstFrame; }) - chunks.begin()) - 1;
+    bool sameChunk = position != NoFrame && loadedChunk == target && frame >= position;
+    if (!sameChunk && !loadChunk(target)) {
+        std::cerr << "Erreur : bloc illisible dans " << path << std::endl;
+        return false;
+    }
+    while (position != frame) {
+        if (!applyFrame()) {
+            std::cerr << "Erreur : image " << position + 1 << " illisible dans " << path << std::endl;
+            return false;
+        }
+    }
+    grid = *current;
+    frameGeneration = generation;
+    return true;
+}
+
+}
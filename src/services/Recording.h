@@ -0,0 +1,126 @@
+// Recording.h
+#pragma once
+#include "components/Grid.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace GameOfLife {
+
+// Enregistrement d'une partie (extension .golr) : un flux en ajout seul de
+// blocs compressés, chacun commençant par une image complète suivie des
+// deltas XOR des générations suivantes. Un index des blocs en fin de
+// fichier permet l'accès direct ; sans lui (enregistrement interrompu),
+// les blocs sont parcourus un à un.
+namespace Recording {
+
+const char Extension[] = ".golr";
+const uint16_t Version = 2;  // 2 : codage entropique à quatre états
+const size_t FramesPerChunk = 64;
+
+}
+
+// Écrit les générations transmises par record() depuis un thread
+// d'arrière-plan : le thread appelant ne fait qu'une copie de la grille
+// (pointeurs de tuiles partagées).
+class Recorder {
+public:
+    Recorder();
+    ~Recorder();  // Termine l'enregistrement
+
+    Recorder(const Recorder&) = delete;
+    Recorder& operator=(const Recorder&) = delete;
+
+    // Crée le fichier ; grid est la première image
+    bool start(const std::string& path, const Grid& grid, uint64_t generation);
+    void record(const Grid& grid, uint64_t generation);
+    // Écrit le dernier bloc et l'index ; faux si une écriture a échoué
+    bool stop();
+
+    bool isRecording() const { return recording; }
+    uint64_t getFrameCount() const { return frameCount; }
+    const std::string& getPath() const { return path; }
+
+private:
+    struct Frame {
+        Grid grid;
+        uint64_t generation;
+    };
+
+    std::string path;
+    bool recording;
+    uint64_t frameCount;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable drained;
+    std::deque<Frame> queue;
+    std::thread writer;
+    bool stopping;
+
+    // État du thread d'écriture
+    std::ofstream file;
+    std::unique_ptr<Grid> previous;
+    std::vector<uint8_t> chunk;           // Images du bloc en cours, non compressées
+    size_t chunkFrames;
+    uint64_t chunkFirstFrame;
+    uint64_t writtenFrames;
+    std::vector<std::pair<uint64_t, uint64_t>> index;  // (première image, position) par bloc
+    bool failed;
+
+    void run();
+    void encode(Frame& frame);
+    void flushChunk();
+};
+
+// Relecture d'un enregistrement, image par image ou par accès direct
+class RecordingPlayer {
+public:
+    RecordingPlayer();
+
+    bool open(const std::string& path);
+    uint64_t getFrameCount() const { return frameCount; }
+    uint64_t getPosition() const { return position; }
+
+    // Image suivante ; faux à la fin de l'enregistrement
+    bool next(Grid& grid, uint64_t& generation);
+    bool seek(uint64_t frame, Grid& grid, uint64_t& generation);
+
+private:
+    struct Chunk {
+        uint64_t firstFrame;
+        uint64_t offset;
+        uint32_t frames;
+        uint32_t rawSize;
+        uint32_t packedSize;
+    };
+
+    std::string path;
+    std::ifstream file;
+    uint64_t fileSize;
+    std::vector<Chunk> chunks;
+    uint64_t frameCount;
+    uint64_t position;     // Image actuellement dans current
+
+    std::unique_ptr<Grid> current;
+    uint64_t generation;
+    size_t loadedChunk;    // Bloc décompressé dans raw
+    std::vector<uint8_t> raw;
+    size_t rawPos;         // Début de l'image suivante dans raw
+
+    bool readHeader();
+    bool readIndex();
+    bool scanChunks();
+    // En-tête de bloc cohérent avec sa position, sa première image et la taille du fichier
+    bool readChunkHeader(uint64_t offset, uint64_t firstFrame, Chunk& chunk);
+    bool loadChunk(size_t index);
+    bool applyFrame();
+};
+
+}
@@ -0,0 +1,403 @@
+// RleFormat.cpp
+#include "services/RleFormat.h"
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace GameOfLife {
+namespace RleFormat {
+
+namespace {
+
+const size_t ChunkSize = 1 << 20;
+const size_t MaxLineLength = 70;
+
+int countTrailingZeros(uint64_t value) {
+#if defined(__GNUC__)
+    return value ? __builtin_ctzll(value) : 64;
+#else
+    int count = 0;
+    while (count < 64 && !((value >> count) & 1)) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+std::string trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t\r");
+    size_t last = text.find_last_not_of(" \t\r");
+    return first == std::string::npos ? "" : text.substr(first, last - first + 1);
+}
+
+// Décodeur incrémental : le fichier lui est fourni par blocs
+class Decoder {
+public:
+    Decoder(const std::string& path, int minWidth, int minHeight)
+        : path(path), minWidth(minWidth), minHeight(minHeight), phase(LineStart),
+          line(1), offsetX(0), offsetY(0), x(0), y(0), count(0), counted(false), prefix(0), clipped(false),
+          tileIndex(-1), tile(nullptr) {
+    }
+
+    bool feed(const char* data, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            char c = data[i];
+            switch (phase) {
+                case LineStart:
+                    if (c == '#') {
+                        phase = Comment;
+                    } else if (c == 'x') {
+                        header = c;
+                        phase = Header;
+                    } else if (c == '\n') {
+                        ++line;
+                    } else if (c != ' ' && c != '\t' && c != '\r') {
+                        return fail("en-tête \"x = ..., y = ...\" manquant");
+                    }
+                    break;
+                case Comment:
+                    if (c == '\n') {
+                        ++line;
+                        phase = LineStart;
+                    }
+                    break;
+                case Header:
+                    if (c == '\n') {
+                        if (!parseHeader()) {
+                            return false;
+                        }
+                        ++line;
+                        phase = Data;
+                    } else {
+                        header += c;
+                    }
+                    break;
+                case Data:
+                    if (!decode(c)) {
+                        return false;
+                    }
+                    break;
+                case Done:
+                    return true;
+            }
+        }
+        return true;
+    }
+
+    bool finish(Grid& result) {
+        if (phase == Header && !parseHeader()) {
+            return false;
+        }
+        if (!grid) {
+            return fail("en-tête \"x = ..., y = ...\" manquant");
+        }
+        if (counted || prefix != 0) {
+            return fail("balise incomplète en fin de fichier");
+        }
+        if (clipped) {
+            std::cerr << "Attention : cellules hors des dimensions du motif ignorées dans " << path << std::endl;
+        }
+        result = std::move(*grid);
+        return true;
+    }
+
+private:
+    enum Phase { LineStart, Comment, Header, Data, Done };
+
+    std::string path;
+    int minWidth;
+    int minHeight;
+    Phase phase;
+    std::string header;
+    int line;
+
+    std::unique_ptr<Grid> grid;
+    int width;
+    int height;
+    int offsetX;
+    int offsetY;
+    long long x;
+    long long y;
+    long long count;
+    bool counted;   // Nombre de répétitions lu, en attente de sa balise
+    char prefix;    // Première lettre d'un état étendu ("p" à "y"), en attente de la seconde
+    bool clipped;
+
+    // Dernière tuile modifiée : le motif est décodé ligne par ligne
+    int tileIndex;
+    Grid::Tile* tile;
+
+    bool fail(const std::string& message) {
+        std::cerr << "Erreur RLE (" << path << ", ligne " << line << ") : " << message << std::endl;
+        return false;
+    }
+
+    bool parseHeader() {
+        long long w = -1, h = -1;
+        uint16_t birth = Grid::ConwayBirth;
+        uint16_t survival = Grid::ConwaySurvival;
+        bool toroidal = false;
+
+        size_t start = 0;
+        while (start <= header.size()) {
+            size_t end = header.find(',', start);
+            if (end == std::string::npos) {
+                end = header.size();
+            }
+            std::string field = header.substr(start, end - start);
+            start = end + 1;
+
+            // Un champ sans "=" est la hauteur du suffixe ":T<largeur>,<hauteur>"
+            size_t equal = field.find('=');
+            if (equal == std::string::npos) {
+                continue;
+            }
+            std::string key = trim(field.substr(0, equal));
+            std::string value = trim(field.substr(equal + 1));
+            if (key == "x" || key == "y") {
+                long long number = -1;
+                try {
+                    number = std::stoll(value);
+                } catch (...) {
+                }
+                if (number <= 0 || number > Grid::MaxDimension) {
+                    return fail("dimension invalide \"" + value + "\"");
+                }
+                (key == "x" ? w : h) = number;
+            } else if (key == "rule") {
+                // Suffixe de topologie de Golly : ":T<largeur>,<hauteur>"
+                size_t colon = value.find(':');
+                if (colon != std::string::npos) {
+                    toroidal = value.compare(colon + 1, 1, "T") == 0 || value.compare(colon + 1, 1, "t") == 0;
+                    value = value.substr(0, colon);
+                }
+                if (!Grid::parseRule(value, birth, survival)) {
+                    return fail("règle non reconnue \"" + value + "\"");
+                }
+            }
+        }
+        if (w < 0 || h < 0) {
+            return fail("dimensions x et y manquantes");
+        }
+
+        width = static_cast<int>(w);
+        height = static_cast<int>(h);
+        int gridWidth = std::max(width, minWidth);
+        int gridHeight = std::max(height, minHeight);
+        if (static_cast<long long>(gridWidth) * gridHeight / (Grid::TileSize * Grid::TileSize) > INT_MAX / 2) {
+            return fail("grille trop grande");
+        }
+        grid.reset(new Grid(gridWidth, gridHeight));
+        grid->setRule(birth, survival);
+        grid->setToroidal(toroidal);
+        offsetX = (gridWidth - width) / 2;
+        offsetY = (gridHeight - height) / 2;
+        return true;
+    }
+
+    bool decode(char c) {
+        // Règles à plusieurs états : les états 1 à 24 s'écrivent "A" à "X", les
+        // suivants "pA" à "yX" ; tous comptent comme vivants
+        if (prefix != 0) {
+            if (c < 'A' || c > 'X') {
+                return fail(std::string("état \"") + prefix + "\" incomplet");
+            }
+            prefix = 0;
+            c = 'o';
+        } else if (c >= 'p' && c <= 'y') {
+            prefix = c;
+            return true;
+        }
+
+        if (c >= '0' && c <= '9') {
+            count = count * 10 + (c - '0');
+            counted = true;
+            if (count > Grid::MaxDimension) {
+                return fail("répétition trop grande");
+            }
+            return true;
+        }
+        // Un nombre de répétitions est collé à sa balise
+        if (counted && (c == ' ' || c == '\t' || c == '\r' || c == '\n')) {
+            return fail("nombre de répétitions sans balise");
+        }
+
+        int run = count > 0 ? static_cast<int>(count) : 1;
+        count = 0;
+        counted = false;
+        if (c == 'b' || c == '.') {
+            x += run;
+        } else if (c == 'o' || (c >= 'A' && c <= 'X')) {
+            setRun(run);
+            x += run;
+        } else if (c == '$') {
+            y += run;
+            x = 0;
+        } else if (c == '!') {
+            phase = Done;
+        } else if (c == '\n') {
+            ++line;
+        } else if (c != ' ' && c != '\t' && c != '\r') {
+            return fail(std::string("caractère inattendu '") + c + "'");
+        }
+        return true;
+    }
+
+    void setRun(int run) {
+        if (y >= height || x >= width || x + run > width) {
+            clipped = true;
+        }
+        if (y >= height || x >= width) {
+            return;
+        }
+        int gx = offsetX + static_cast<int>(x);
+        int gy = offsetY + static_cast<int>(y);
+        int remaining = static_cast<int>(std::min<long long>(run, width - x));
+        int row = gy % Grid::TileSize;
+        while (remaining > 0) {
+            int bit = gx % Grid::TileSize;
+            int span = std::min(remaining, Grid::TileSize - bit);
+            int index = (gy / Grid::TileSize) * grid->getTilesX() + gx / Grid::TileSize;
+            if (index != tileIndex) {
+                tile = &grid->getMutableTile(index);
+                tileIndex = index;
+            }
+            uint64_t mask = span == Grid::TileSize ? ~0ULL : ((1ULL << span) - 1) << bit;
+            tile->alive[row] |= mask;
+            gx += span;
+            remaining -= span;
+        }
+    }
+};
+
+// Écriture tamponnée des balises avec retour à la ligne à 70 caractères
+class Encoder {
+public:
+    explicit Encoder(std::ofstream& file) : file(file), lineLength(0) {
+    }
+
+    void emit(long long run, char tag) {
+        std::string token = run > 1 ? std::to_string(run) : std::string();
+        token += tag;
+        if (lineLength + token.size() > MaxLineLength) {
+            buffer += '\n';
+            lineLength = 0;
+        }
+        buffer += token;
+        lineLength += token.size();
+        if (buffer.size() >= ChunkSize) {
+            flush();
+        }
+    }
+
+    void flush() {
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+
+private:
+    std::ofstream& file;
+    std::string buffer;
+    size_t lineLength;
+};
+
+}
+
+bool write(const std::string& path, const Grid& grid) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Erreur : Impossible de créer le fichier " << path << std::endl;
+        return false;
+    }
+
+    file << "x = " << grid.getWidth() << ", y = " << grid.getHeight() << ", rule = " << grid.getRuleString();
+    if (grid.isToroidal()) {
+        file << ":T" << grid.getWidth() << "," << grid.getHeight();
+    }
+    file << "\n";
+
+    Encoder encoder(file);
+    long long pendingRows = 0;
+    long long dead = 0;
+    long long alive = 0;
+
+    // Une plage vivante s'écrit avec les fins de ligne et les cellules mortes qui la précèdent
+    auto flushAlive = [&]() {
+        if (alive == 0) {
+            return;
+        }
+        if (pendingRows > 0) {
+            encoder.emit(pendingRows, '$');
+            pendingRows = 0;
+        }
+        if (dead > 0) {
+            encoder.emit(dead, 'b');
+        }
+        encoder.emit(alive, 'o');
+        dead = alive = 0;
+    };
+
+    for (int y = 0; y < grid.getHeight(); ++y) {
+        int row = y % Grid::TileSize;
+        for (int tx = 0; tx < grid.getTilesX(); ++tx) {
+            uint64_t word = grid.getTile((y / Grid::TileSize) * grid.getTilesX() + tx).alive[row];
+            int limit = std::min(Grid::TileSize, grid.getWidth() - tx * Grid::TileSize);
+            if (word == 0) {
+                flushAlive();
+                dead += limit;
+                continue;
+            }
+
+            // Découpage du mot en plages de bits identiques
+            for (int pos = 0; pos < limit;) {
+                uint64_t rest = word >> pos;
+                int length = (rest & 1) ? countTrailingZeros(~rest) : countTrailingZeros(rest);
+                length = std::min(length, limit - pos);
+                if (rest & 1) {
+                    alive += length;
+                } else {
+                    flushAlive();
+                    dead += length;
+                }
+                pos += length;
+            }
+        }
+        flushAlive();
+        // Les cellules mortes en fin de ligne sont implicites
+        dead = 0;
+        ++pendingRows;
+    }
+    encoder.emit(1, '!');
+    encoder.flush();
+    file << "\n";
+
+    if (!file) {
+        std::cerr << "Erreur : écriture incomplète de " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool read(const std::string& path, Grid& grid, int minWidth, int minHeight) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Erreur lors de l'ouverture du fichier de sauvegarde " << path << std::endl;
+        return false;
+    }
+
+    Decoder decoder(path, minWidth, minHeight);
+    std::vector<char> chunk(ChunkSize);
+    while (file) {
+        file.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        if (!decoder.feed(chunk.data(), static_cast<size_t>(file.gcount()))) {
+            return false;
+        }
+    }
+    return decoder.finish(grid);
+}
+
+}
+}
@@ -0,0 +1,29 @@
+// RleFormat.h
+#pragma once
+#include "components/Grid.h"
+#include <string>
+
+namespace GameOfLife {
+
+// Motifs au format RLE (extension .rle), celui des bibliothèques de motifs :
+//   #N Nom          (commentaires facultatifs)
+//   x = 3, y = 3, rule = B3/S23
+//   bo$2bo$3o!
+// "b" cellule morte, "o" vivante, "$" fin de ligne, "!" fin du motif ; un
+// nombre devant une balise la répète. Le suffixe de règle ":T" (Golly)
+// indique une grille torique. Les états des règles à plusieurs états ("A" à
+// "X", "pA" à "yX") sont lus comme vivants. Les obstacles ne sont pas
+// représentables : seules les cellules vivantes sont écrites.
+namespace RleFormat {
+
+const char Extension[] = ".rle";
+
+bool write(const std::string& path, const Grid& grid);
+
+// Décode le fichier par blocs, directement dans les plans de bits de grid.
+// La grille fait au moins minWidth x minHeight : le motif y est centré.
+bool read(const std::string& path, Grid& grid, int minWidth = 0, int minHeight = 0);
+
+}
+
+}
@@ -0,0 +1,240 @@
+// SaveIndex.cpp
+#include "services/SaveIndex.h"
+#include "services/BinarySave.h"
+#include "services/Game.h"
+#include "services/MacrocellFormat.h"
+#include "services/Recording.h"
+#include "services/RleFormat.h"
+#include "services/SaveQueue.h"
+#include "services/TextSave.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace GameOfLife {
+
+namespace {
+
+const char Magic[] = "GOLI 1";
+const size_t HashBlockSize = 1 << 20;
+
+bool endsWith(const std::string& text, const char* suffix) {
+    size_t length = std::strlen(suffix);
+    return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+uint64_t mix(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDULL;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+// Ligne d'index : champs séparés par des tabulations
+bool parseEntry(const std::string& line, SaveIndex::Entry& entry) {
+    std::vector<std::string> fields;
+    std::stringstream stream(line);
+    std::string field;
+    while (std::getline(stream, field, '\t')) {
+        fields.push_back(field);
+    }
+    if (fields.size() != 10 || fields[0].empty()) {
+        return false;
+    }
+    try {
+        entry.name = fields[0];
+        entry.size = std::stoull(fields[1]);
+        entry.modified = std::stoll(fields[2]);
+        entry.readable = fields[3] == "1";
+        entry.width = std::stoll(fields[4]);
+        entry.height = std::stoll(fields[5]);
+        entry.population = std::stoull(fields[6]);
+        entry.rule = fields[7];
+        entry.generation = std::stoull(fields[8]);
+        entry.hash = std::stoull(fields[9], nullptr, 16);
+    } catch (...) {
+        return false;
+    }
+    return true;
+}
+
+}
+
+const char SaveIndex::FileName[] = ".index";
+
+SaveIndex::SaveIndex(const std::string& directory) : directory(directory), loaded(false) {
+    if (!this->directory.empty() && this->directory.back() != '/') {
+        this->directory += '/';
+    }
+}
+
+void SaveIndex::refresh() {
+    // Entrées connues : l'index sur disque au premier appel, puis la mémoire
+    std::unordered_map<std::string, Entry> known;
+    bool changed = false;
+    if (!loaded) {
+        changed = !load(known);
+        loaded = true;
+    } else {
+        for (Entry& entry : entries) {
+            known.emplace(entry.name, std::move(entry));
+        }
+    }
+
+    std::vector<Entry> current;
+    std::error_code error;
+    for (const auto& file : fs::directory_iterator(directory, error)) {
+        std::string name = file.path().filename().string();
+        if (!Game::isSaveFile(name) || !file.is_regular_file(error) ||
+            name.find_first_of("\t\n") != std::string::npos) {
+            continue;
+        }
+        uint64_t size = file.file_size(error);
+        int64_t modified = static_cast<int64_t>(file.last_write_time(error).time_since_epoch().count());
+        if (error) {
+            continue;
+        }
+
+        auto found = known.find(name);
+        if (found != known.end() && found->second.size == size && found->second.modified == modified) {
+            current.push_back(std::move(found->second));
+            known.erase(found);
+            continue;
+        }
+
+        // Nouveau fichier ou fichier modifié : seule analyse complète
+        Entry entry = Entry{name, size, modified, false, 0, 0, 0, "", 0, 0};
+        entry.readable = analyze(directory + name, entry);
+        current.push_back(std::move(entry));
+        changed = true;
+    }
+    // Fichiers supprimés depuis la dernière lecture
+    changed = changed || !known.empty();
+
+    std::sort(current.begin(), current.end(),
+              [](const Entry& a, const Entry& b) { return a.name < b.name; });
+    entries = std::move(current);
+    if (changed) {
+        save();
+    }
+}
+
+std::string SaveIndex::describe(const Entry& entry) {
+    if (!entry.readable) {
+        return "illisible";
+    }
+    std::string text = std::to_string(entry.width) + " x " + std::to_string(entry.height) + ", " +
+                       std::to_string(entry.population) + " cellules, " + entry.rule;
+    if (entry.generation > 0) {
+        text += ", génération " + std::to_string(entry.generation);
+    }
+    return text;
+}
+
+uint64_t SaveIndex::hashFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::vector<char> block(HashBlockSize);
+    uint64_t hash = 0x9E3779B97F4A7C15ULL;
+    uint64_t length = 0;
+    while (file) {
+        file.read(block.data(), static_cast<std::streamsize>(block.size()));
+        size_t count = static_cast<size_t>(file.gcount());
+        length += count;
+        // Octets manquants du dernier mot à zéro ; la longueur est mélangée à la fin
+        std::fill(block.begin() + static_cast<std::ptrdiff_t>(count),
+                  block.begin() + static_cast<std::ptrdiff_t>((count + 7) / 8 * 8), 0);
+        for (size_t i = 0; i < count; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, block.data() + i, sizeof(word));
+            hash = (hash ^ word) * 0x100000001B3ULL;
+            hash ^= hash >> 29;
+        }
+    }
+    return mix(hash ^ length);
+}
+
+bool SaveIndex::load(std::unordered_map<std::string, Entry>& known) const {
+    std::ifstream file(directory + FileName);
+    std::string line;
+    if (!std::getline(file, line) || line != Magic) {
+        return false;
+    }
+    while (std::getline(file, line)) {
+        Entry entry;
+        if (parseEntry(line, entry)) {
+            std::string name = entry.name;
+            known.emplace(std::move(name), std::move(entry));
+        }
+    }
+    return true;
+}
+
+bool SaveIndex::save() const {
+    return SaveQueue::writeAtomically(directory + FileName, [this](const std::string& path) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << Magic << "\n";
+        for (const Entry& entry : entries) {
+            file << entry.name << '\t' << entry.size << '\t' << entry.modified << '\t'
+                 << (entry.readable ? 1 : 0) << '\t' << entry.width << '\t' << entry.height << '\t'
+                 << entry.population << '\t' << entry.rule << '\t' << entry.generation << '\t'
+                 << std::hex << entry.hash << std::dec << '\n';
+        }
+        return static_cast<bool>(file);
+    });
+}
+
+bool SaveIndex::readSave(const std::string& path, Grid& grid, Quadtree& tree,
+                         uint64_t& generation, bool& isPattern) {
+    generation = 0;
+    isPattern = endsWith(path, MacrocellFormat::Extension);
+    if (isPattern) {
+        uint16_t birth, survival;
+        if (!MacrocellFormat::read(path, tree, birth, survival, generation)) {
+            return false;
+        }
+        grid.setRule(birth, survival);
+        return true;
+    }
+    if (endsWith(path, BinarySave::Extension)) {
+        return BinarySave::read(path, grid, generation);
+    }
+    if (endsWith(path, RleFormat::Extension)) {
+        return RleFormat::read(path, grid);
+    }
+    if (endsWith(path, Recording::Extension)) {
+        // Première image de l'enregistrement
+        RecordingPlayer player;
+        return player.open(path) && player.next(grid, generation);
+    }
+    return TextSave::read(path, grid);
+}
+
+bool SaveIndex::analyze(const std::string& path, Entry& entry) const {
+    Grid grid(1, 1);
+    Quadtree tree;
+    bool isPattern = false;
+    if (!readSave(path, grid, tree, entry.generation, isPattern)) {
+        return false;
+    }
+    if (isPattern) {
+        // Le motif n'est pas déplié : tout se lit sur la racine de l'arbre
+        entry.width = entry.height = int64_t(1) << tree.getRootLevel();
+        entry.population = tree.populationOf(tree.getRoot());
+    } else {
+        entry.width = grid.getWidth();
+        entry.height = grid.getHeight();
+        entry.population = static_cast<uint64_t>(grid.countAlive());
+    }
+    entry.rule = grid.getRuleString();
+    entry.hash = hashFile(path);
+    return true;
+}
+
+}
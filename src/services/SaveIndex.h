@@ -0,0 +1,62 @@
+// SaveIndex.h
+#pragma once
+#include "components/Quadtree.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace GameOfLife {
+
+// Index des sauvegardes d'un répertoire, conservé dans le fichier ".index"
+// de ce répertoire. Seuls les fichiers nouveaux ou modifiés (taille ou date)
+// sont relus : les menus de chargement s'affichent sans analyser chaque
+// sauvegarde.
+class SaveIndex {
+public:
+    static const char FileName[];
+
+    struct Entry {
+        std::string name;
+        uint64_t size;
+        int64_t modified;     // Date de modification (unités du système de fichiers)
+        bool readable;        // Faux si le fichier n'a pas pu être analysé
+        int64_t width;        // Un motif .mc fait 2^niveau de côté
+        int64_t height;
+        uint64_t population;
+        std::string rule;
+        uint64_t generation;
+        uint64_t hash;        // Empreinte du contenu (clé des miniatures)
+    };
+
+    explicit SaveIndex(const std::string& directory);
+
+    // Relit le répertoire et réécrit l'index s'il a changé
+    void refresh();
+
+    // Sauvegardes reconnues par Game::isSaveFile, triées par nom
+    const std::vector<Entry>& getEntries() const { return entries; }
+
+    // Résumé lisible : "80 x 80, 312 cellules, B3/S23, génération 40"
+    static std::string describe(const Entry& entry);
+
+    // Empreinte 64 bits du contenu d'un fichier
+    static uint64_t hashFile(const std::string& path);
+
+    // Lit une sauvegarde quel que soit son format. Un motif .mc reste sous
+    // forme d'arbre : tree est rempli, isPattern vaut vrai et grid n'est
+    // porteuse que de la règle.
+    static bool readSave(const std::string& path, Grid& grid, Quadtree& tree,
+                         uint64_t& generation, bool& isPattern);
+
+private:
+    std::string directory;
+    std::vector<Entry> entries;
+    bool loaded;
+
+    bool load(std::unordered_map<std::string, Entry>& known) const;
+    bool save() const;
+    bool analyze(const std::string& path, Entry& entry) const;
+};
+
+}
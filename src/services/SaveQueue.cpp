@@ -0,0 +1,170 @@
+// SaveQueue.cpp
+#include "services/SaveQueue.h"
+#include <atomic>
+#include <cstdio>
+#include <iostream>
+
+#ifdef _WIN32
+#include <filesystem>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace GameOfLife {
+
+namespace {
+
+// Force l'écriture sur disque d'un fichier (ou d'un répertoire sous POSIX)
+bool syncPath(const std::string& path, bool directory) {
+#ifdef _WIN32
+    (void)path;
+    (void)directory;
+    return true;
+#else
+    int fd = ::open(path.c_str(), directory ? O_RDONLY : O_WRONLY);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+    return ok || directory;  // Certains systèmes refusent fsync sur un répertoire
+#endif
+}
+
+std::string directoryOf(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    return slash == std::string::npos ? "." : path.substr(0, slash == 0 ? 1 : slash);
+}
+
+}
+
+SaveQueue::SaveQueue() : stopping(false), working(false), maxPending(0), overflow(Block), dropped(0) {
+}
+
+SaveQueue::~SaveQueue() {
+    if (!worker.joinable()) {
+        return;
+    }
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    worker.join();
+}
+
+void SaveQueue::submit(const std::string& path, Writer writer) {
+    Job discarded;  // Instantané abandonné, libéré hors du verrou
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (maxPending != 0 && jobs.size() >= maxPending) {
+            if (overflow == Block) {
+                // Le thread appelant suit le rythme du disque
+                // setLimit(0, ...) pendant l'attente lève la limite
+                space.wait(lock, [this] { return maxPending == 0 || jobs.size() < maxPending; });
+            } else {
+                discarded = std::move(jobs.front());
+                jobs.pop_front();
+                ++dropped;
+            }
+        }
+        jobs.push_back(Job{path, std::move(writer)});
+        if (!worker.joinable()) {
+            worker = std::thread(&SaveQueue::run, this);
+        }
+    }
+    wake.notify_one();
+}
+
+void SaveQueue::setLimit(size_t maxPending, Overflow overflow) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->maxPending = maxPending;
+        this->overflow = overflow;
+    }
+    space.notify_all();
+}
+
+uint64_t SaveQueue::getDropped() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return dropped;
+}
+
+bool SaveQueue::poll(Result& result) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (results.empty()) {
+        return false;
+    }
+    result = std::move(results.front());
+    results.pop_front();
+    return true;
+}
+
+bool SaveQueue::busy() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return working || !jobs.empty();
+}
+
+void SaveQueue::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return !working && jobs.empty(); });
+}
+
+bool SaveQueue::writeAtomically(const std::string& path, const Writer& writer) {
+    // Nom temporaire unique : plusieurs sauvegardes du même fichier peuvent coexister
+    static std::atomic<unsigned> counter(0);
+    std::string temporary = path + "." + std::to_string(counter++) + ".tmp";
+
+    if (!writer(temporary)) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    if (!syncPath(temporary, false)) {
+        std::cerr << "Erreur : impossible de synchroniser " << temporary << " sur le disque" << std::endl;
+        std::remove(temporary.c_str());
+        return false;
+    }
+
+#ifdef _WIN32
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    bool renamed = !error;
+#else
+    bool renamed = std::rename(temporary.c_str(), path.c_str()) == 0;
+#endif
+    if (!renamed) {
+        std::cerr << "Erreur : impossible de remplacer " << path << std::endl;
+        std::remove(temporary.c_str());
+        return false;
+    }
+    // Le renommage lui-même doit survivre à une coupure
+    syncPath(directoryOf(path), true);
+    return true;
+}
+
+void SaveQueue::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+        if (jobs.empty()) {
+            break;
+        }
+
+        Job job = std::move(jobs.front());
+        jobs.pop_front();
+        working = true;
+        space.notify_one();
+        lock.unlock();
+        bool success = writeAtomically(job.path, job.writer);
+        job.writer = nullptr;  // Libère l'instantané hors du verrou
+        lock.lock();
+        working = false;
+
+        results.push_back(Result{job.path, success});
+        idle.notify_all();
+    }
+}
+
+}
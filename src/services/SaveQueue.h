@@ -0,0 +1,76 @@
+// SaveQueue.h
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace GameOfLife {
+
+// Sauvegardes exécutées par un thread d'entrée/sortie : submit() ne fait que
+// mettre en file une tâche d'écriture, qui travaille sur un instantané déjà
+// pris par l'appelant. Chaque fichier est écrit de façon atomique : fichier
+// temporaire, fsync, puis renommage, si bien qu'une sauvegarde interrompue ne
+// laisse jamais de fichier tronqué.
+class SaveQueue {
+public:
+    // Écrit le fichier au chemin donné (le fichier temporaire)
+    using Writer = std::function<bool(const std::string& path)>;
+
+    struct Result {
+        std::string path;
+        bool success;
+    };
+
+    // Comportement d'une file bornée pleine
+    enum Overflow {
+        Block,       // submit() attend qu'une place se libère
+        DropOldest   // La sauvegarde en attente la plus ancienne est abandonnée
+    };
+
+    SaveQueue();
+    ~SaveQueue();  // Termine les sauvegardes en attente
+
+    SaveQueue(const SaveQueue&) = delete;
+    SaveQueue& operator=(const SaveQueue&) = delete;
+
+    void submit(const std::string& path, Writer writer);
+
+    // Au plus maxPending sauvegardes en attente (hors celle en cours) ; 0 : pas de limite
+    void setLimit(size_t maxPending, Overflow overflow);
+    uint64_t getDropped() const;
+
+    // Sauvegarde terminée depuis le dernier appel (une par appel)
+    bool poll(Result& result);
+    bool busy() const;
+    void wait();
+
+    // Écriture atomique dans le thread appelant
+    static bool writeAtomically(const std::string& path, const Writer& writer);
+
+private:
+    struct Job {
+        std::string path;
+        Writer writer;
+    };
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::condition_variable space;
+    std::deque<Job> jobs;
+    std::deque<Result> results;
+    std::thread worker;  // Démarré à la première sauvegarde
+    bool stopping;
+    bool working;
+    size_t maxPending;
+    Overflow overflow;
+    uint64_t dropped;
+
+    void run();
+};
+
+}
@@ -0,0 +1,267 @@
+// SpillFile.cpp
+#include "services/SpillFile.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace GameOfLife {
+
+namespace {
+
+// La projection grandit par paliers pour limiter les remappages
+const size_t MappingStep = 16 * 1024 * 1024;
+
+}
+
+SpillFile::SpillFile()
+    : stopping(false), writing(false), reserved(0), written(0)
+#ifndef _WIN32
+      , fd(-1), mapping(nullptr), mappingSize(0)
+#endif
+{
+}
+
+SpillFile::~SpillFile() {
+    close();
+}
+
+bool SpillFile::open() {
+    if (isOpen()) {
+        return true;
+    }
+
+#ifdef _WIN32
+    auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    path = (std::filesystem::temp_directory_path() /
+            ("gameoflife-" + std::to_string(stamp) + ".spill")).string();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Erreur : impossible de créer le fichier d'échange " << path << std::endl;
+        path.clear();
+        return false;
+    }
+#else
+    const char* directory = std::getenv("TMPDIR");
+    std::string name = std::string(directory && *directory ? directory : "/tmp") + "/gameoflife-XXXXXX";
+    std::vector<char> buffer(name.begin(), name.end());
+    buffer.push_back('\0');
+    fd = ::mkstemp(buffer.data());
+    if (fd < 0) {
+        std::cerr << "Erreur : impossible de créer le fichier d'échange dans " << name << std::endl;
+        return false;
+    }
+    // Fichier anonyme : supprimé par le système à la fermeture
+    ::unlink(buffer.data());
+#endif
+
+    stopping = false;
+    reserved = 0;
+    written = 0;
+    writer = std::thread(&SpillFile::run, this);
+    return true;
+}
+
+bool SpillFile::isOpen() const {
+#ifdef _WIN32
+    return !path.empty();
+#else
+    return fd >= 0;
+#endif
+}
+
+void SpillFile::close() {
+    if (!isOpen()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    writer.join();
+    queue.clear();
+
+#ifdef _WIN32
+    std::remove(path.c_str());
+    path.clear();
+#else
+    unmap();
+    ::close(fd);
+    fd = -1;
+#endif
+}
+
+uint64_t SpillFile::append(std::vector<uint8_t>&& data) {
+    uint64_t offset;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        offset = reserved;
+        reserved += data.size();
+        queue.push_back(Pending{offset, std::move(data)});
+    }
+    wake.notify_one();
+    return offset;
+}
+
+bool SpillFile::read(uint64_t offset, size_t size, std::vector<uint8_t>& out) const {
+    if (size == 0) {
+        out.clear();
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (offset + size > written) {
+        // Pas encore sur le disque : la plage est dans un enregistrement en attente
+        for (const Pending& pending : queue) {
+            if (offset >= pending.offset && offset + size <= pending.offset + pending.data.size()) {
+                auto first = pending.data.begin() + static_cast<std::ptrdiff_t>(offset - pending.offset);
+                out.assign(first, first + static_cast<std::ptrdiff_t>(size));
+                return true;
+            }
+        }
+        return false;
+    }
+    return readAt(offset, size, out);
+}
+
+void SpillFile::reset() {
+    if (!isOpen()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return !writing; });
+    queue.clear();
+    reserved = 0;
+    written = 0;
+#ifdef _WIN32
+    std::ofstream(path, std::ios::binary | std::ios::trunc);
+#else
+    unmap();
+    if (::ftruncate(fd, 0) != 0) {
+        std::cerr << "Erreur : impossible de vider le fichier d'échange" << std::endl;
+    }
+#endif
+
+    // Après une erreur d'écriture, le thread s'est arrêté : le fichier vidé
+    // est de nouveau utilisable
+    if (stopping) {
+        lock.unlock();
+        writer.join();
+        lock.lock();
+        stopping = false;
+        writer = std::thread(&SpillFile::run, this);
+    }
+}
+
+void SpillFile::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return queue.empty() || stopping; });
+}
+
+bool SpillFile::good() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return isOpen() && !stopping;
+}
+
+uint64_t SpillFile::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return reserved;
+}
+
+void SpillFile::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this] { return stopping || !queue.empty(); });
+        if (stopping) {
+            break;
+        }
+
+        // L'élément reste dans la file pendant l'écriture pour rester lisible
+        writing = true;
+        const Pending& pending = queue.front();
+        lock.unlock();
+        bool ok = writeAt(pending.offset, pending.data);
+        lock.lock();
+        writing = false;
+
+        if (ok) {
+            written = queue.front().offset + queue.front().data.size();
+            queue.pop_front();
+        } else {
+            // Disque plein ou erreur d'écriture : on garde les données en mémoire
+            std::cerr << "Erreur : écriture impossible dans le fichier d'échange" << std::endl;
+            stopping = true;
+        }
+        idle.notify_all();
+    }
+    writing = false;
+    idle.notify_all();
+}
+
+bool SpillFile::writeAt(uint64_t offset, const std::vector<uint8_t>& data) {
+#ifdef _WIN32
+    // Écriture à la position demandée, comme pwrite
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(static_cast<std::streamoff>(offset));
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+#else
+    size_t done = 0;
+    while (done < data.size()) {
+        ssize_t n = ::pwrite(fd, data.data() + done, data.size() - done, static_cast<off_t>(offset + done));
+        if (n <= 0) {
+            return false;
+        }
+        done += static_cast<size_t>(n);
+    }
+    return true;
+#endif
+}
+
+bool SpillFile::readAt(uint64_t offset, size_t size, std::vector<uint8_t>& out) const {
+#ifdef _WIN32
+    std::ifstream file(path, std::ios::binary);
+    file.seekg(static_cast<std::streamoff>(offset));
+    out.resize(size);
+    file.read(reinterpret_cast<char*>(out.data()), size);
+    return static_cast<bool>(file);
+#else
+    if (offset + size > mappingSize) {
+        // Projeter au-delà de la fin actuelle : seules les pages écrites sont lues
+        unmap();
+        size_t length = std::max<size_t>(static_cast<size_t>(written), mappingSize) + MappingStep;
+        void* address = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        if (address == MAP_FAILED) {
+            return false;
+        }
+        mapping = address;
+        mappingSize = length;
+    }
+    out.resize(size);
+    std::memcpy(out.data(), static_cast<const uint8_t*>(mapping) + offset, size);
+    return true;
+#endif
+}
+
+void SpillFile::unmap() const {
+#ifndef _WIN32
+    if (mapping) {
+        ::munmap(mapping, mappingSize);
+        mapping = nullptr;
+        mappingSize = 0;
+    }
+#endif
+}
+
+}
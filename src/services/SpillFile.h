@@ -0,0 +1,76 @@
+// SpillFile.h
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace GameOfLife {
+
+// Fichier temporaire en ajout seul servant de débordement sur disque.
+// Les écritures sont confiées à un thread d'arrière-plan : append() ne bloque
+// jamais sur le disque. Les relectures passent par une projection mémoire
+// (mmap) du fichier, ou par la file d'attente si l'écriture n'est pas finie.
+class SpillFile {
+public:
+    SpillFile();
+    ~SpillFile();
+
+    SpillFile(const SpillFile&) = delete;
+    SpillFile& operator=(const SpillFile&) = delete;
+
+    // Crée le fichier dans le répertoire temporaire du système
+    bool open();
+    bool isOpen() const;
+    bool good() const;    // Ouvert et sans erreur d'écriture
+    void close();
+
+    // Ajoute un enregistrement et retourne sa position dans le fichier
+    uint64_t append(std::vector<uint8_t>&& data);
+
+    // Relit size octets à la position offset (plage d'un même enregistrement)
+    bool read(uint64_t offset, size_t size, std::vector<uint8_t>& out) const;
+
+    // Vide le fichier (les positions déjà retournées deviennent invalides)
+    void reset();
+
+    // Attend la fin des écritures en cours
+    void flush();
+
+    uint64_t size() const;
+
+private:
+    struct Pending {
+        uint64_t offset;
+        std::vector<uint8_t> data;
+    };
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::deque<Pending> queue;
+    std::thread writer;
+    bool stopping;
+    bool writing;         // Le thread écrit l'élément en tête de file
+    uint64_t reserved;    // Fin logique du fichier (écritures en attente incluses)
+    uint64_t written;     // Octets effectivement écrits
+
+#ifdef _WIN32
+    std::string path;
+#else
+    int fd;
+    mutable void* mapping;
+    mutable size_t mappingSize;
+#endif
+
+    void run();
+    bool writeAt(uint64_t offset, const std::vector<uint8_t>& data);
+    bool readAt(uint64_t offset, size_t size, std::vector<uint8_t>& out) const;
+    void unmap() const;
+};
+
+}
@@ -0,0 +1,62 @@
+// SpscQueue.h
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace GameOfLife {
+
+// File circulaire sans verrou entre un seul producteur et un seul
+// consommateur : push() et pop() ne font qu'une lecture et une écriture
+// atomiques chacun, sans jamais bloquer. La capacité est arrondie à la
+// puissance de 2 supérieure.
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity) : head(0), tail(0) {
+        size_t size = 2;
+        while (size < capacity) {
+            size *= 2;
+        }
+        slots.resize(size);
+        mask = size - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producteur ; faux si la file est pleine (élément non ajouté)
+    bool push(const T& value) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) > mask) {
+            return false;
+        }
+        slots[t & mask] = value;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consommateur ; faux si la file est vide
+    bool pop(T& value) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = slots[h & mask];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<T> slots;
+    size_t mask;
+    // Chaque index sur sa propre ligne de cache : pas de faux partage
+    alignas(64) std::atomic<size_t> head;  // Prochain élément lu
+    alignas(64) std::atomic<size_t> tail;  // Prochain emplacement écrit
+};
+
+}
@@ -0,0 +1,111 @@
+// TerminalInput.cpp
+#include "services/TerminalInput.h"
+#include <csignal>
+
+#ifdef _WIN32
+#include <conio.h>
+#else
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+namespace GameOfLife {
+
+namespace {
+
+volatile std::sig_atomic_t interrupted = 0;
+
+void onInterrupt(int) {
+    interrupted = 1;
+    std::signal(SIGINT, SIG_DFL);  // Un second Ctrl+C arrête le programme
+}
+
+}
+
+bool TerminalInput::isInterrupted() const {
+    return interrupted != 0;
+}
+
+#ifdef _WIN32
+
+struct TerminalInput::SavedMode {
+};
+
+TerminalInput::TerminalInput() {
+    interrupted = 0;
+    previousHandler = std::signal(SIGINT, onInterrupt);
+}
+
+TerminalInput::~TerminalInput() {
+    std::signal(SIGINT, previousHandler);
+}
+
+int TerminalInput::poll() {
+    if (!_kbhit()) {
+        return -1;
+    }
+    int key = _getch();
+    if (key != 0 && key != 224) {
+        return key;
+    }
+    // Touche étendue : second code
+    switch (_getch()) {
+        case 72: return ArrowUp;
+        case 80: return ArrowDown;
+        case 75: return ArrowLeft;
+        case 77: return ArrowRight;
+        default: return -1;
+    }
+}
+
+#else
+
+struct TerminalInput::SavedMode {
+    termios mode;
+};
+
+TerminalInput::TerminalInput() {
+    interrupted = 0;
+    previousHandler = std::signal(SIGINT, onInterrupt);
+    termios mode;
+    if (!::isatty(STDIN_FILENO) || ::tcgetattr(STDIN_FILENO, &mode) != 0) {
+        return;
+    }
+    saved.reset(new SavedMode{mode});
+    // Ni écho ni tampon de ligne ; read() rend la main immédiatement
+    mode.c_lflag &= ~static_cast<tcflag_t>(ICANON | ECHO);
+    mode.c_cc[VMIN] = 0;
+    mode.c_cc[VTIME] = 0;
+    ::tcsetattr(STDIN_FILENO, TCSANOW, &mode);
+}
+
+TerminalInput::~TerminalInput() {
+    std::signal(SIGINT, previousHandler);
+    if (saved) {
+        ::tcsetattr(STDIN_FILENO, TCSANOW, &saved->mode);
+    }
+}
+
+int TerminalInput::poll() {
+    unsigned char key;
+    if (!saved || ::read(STDIN_FILENO, &key, 1) != 1) {
+        return -1;
+    }
+    // Flèches : séquence ESC [ A..D
+    unsigned char sequence[2];
+    if (key != 0x1b || ::read(STDIN_FILENO, &sequence[0], 1) != 1 || sequence[0] != '[' ||
+        ::read(STDIN_FILENO, &sequence[1], 1) != 1) {
+        return key;
+    }
+    switch (sequence[1]) {
+        case 'A': return ArrowUp;
+        case 'B': return ArrowDown;
+        case 'D': return ArrowLeft;
+        case 'C': return ArrowRight;
+        default: return -1;
+    }
+}
+
+#endif
+
+}
@@ -0,0 +1,37 @@
+// TerminalInput.h
+#pragma once
+#include <memory>
+
+namespace GameOfLife {
+
+// Lecture des touches du terminal sans attente ni écho, pour piloter
+// l'affichage du mode console pendant la simulation. Le terminal retrouve son
+// mode d'origine à la destruction de l'objet. Pendant ce temps, Ctrl+C ne
+// termine plus le programme mais demande l'arrêt (voir isInterrupted), pour
+// que le terminal soit restauré ; un second Ctrl+C l'interrompt aussitôt.
+class TerminalInput {
+public:
+    // Codes des flèches, au-delà des caractères ordinaires
+    static const int ArrowUp = 256;
+    static const int ArrowDown = 257;
+    static const int ArrowLeft = 258;
+    static const int ArrowRight = 259;
+
+    TerminalInput();
+    ~TerminalInput();
+
+    TerminalInput(const TerminalInput&) = delete;
+    TerminalInput& operator=(const TerminalInput&) = delete;
+
+    // Touche suivante déjà frappée, -1 si aucune (ou si l'entrée n'est pas un terminal)
+    int poll();
+    // Vrai après un Ctrl+C
+    bool isInterrupted() const;
+
+private:
+    struct SavedMode;
+    std::unique_ptr<SavedMode> saved;
+    void (*previousHandler)(int);
+};
+
+}
@@ -0,0 +1,461 @@
+// TerminalRenderer.cpp
+#include "services/TerminalRenderer.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+namespace GameOfLife {
+
+namespace {
+
+const int MaxGap = 4;  // Au-delà, un déplacement du curseur coûte moins que les caractères inchangés
+
+char cellChar(const Grid::Tile& tile, int r, int bit) {
+    if ((tile.alive[r] >> bit) & 1) {
+        return TerminalRenderer::AliveChar;
+    }
+    return ((tile.obstacle[r] >> bit) & 1) ? TerminalRenderer::ObstacleChar : TerminalRenderer::DeadChar;
+}
+
+// Points allumés par un octet d'une ligne de points (8 points, soit 4
+// caractères braille de 2 points de large), pour chacune des 4 lignes d'un
+// caractère : un octet de motif braille par caractère
+struct BrailleTables {
+    uint32_t rows[4][256];
+
+    BrailleTables() {
+        // Numérotation Unicode des points : colonne gauche 1, 2, 3, 7 ; droite 4, 5, 6, 8
+        const uint8_t left[4] = {0x01, 0x02, 0x04, 0x40};
+        const uint8_t right[4] = {0x08, 0x10, 0x20, 0x80};
+        for (int row = 0; row < 4; ++row) {
+            for (int byte = 0; byte < 256; ++byte) {
+                uint32_t codes = 0;
+                for (int glyph = 0; glyph < 4; ++glyph) {
+                    uint32_t code = ((byte >> (2 * glyph)) & 1 ? left[row] : 0) |
+                                    ((byte >> (2 * glyph + 1)) & 1 ? right[row] : 0);
+                    codes |= code << (8 * glyph);
+                }
+                rows[row][byte] = codes;
+            }
+        }
+    }
+};
+
+// Un octet par bit : 8 points d'une ligne, vers 8 caractères demi-bloc
+struct SpreadTable {
+    uint64_t bytes[256];
+
+    SpreadTable() {
+        for (int byte = 0; byte < 256; ++byte) {
+            bytes[byte] = 0;
+            for (int bit = 0; bit < 8; ++bit) {
+                bytes[byte] |= static_cast<uint64_t>((byte >> bit) & 1) << (8 * bit);
+            }
+        }
+    }
+};
+
+const BrailleTables& brailleTables() {
+    static const BrailleTables tables;
+    return tables;
+}
+
+const SpreadTable& spreadTable() {
+    static const SpreadTable table;
+    return table;
+}
+
+// Regroupe les bits deux à deux (OU) : 64 bits deviennent 32 bits contigus
+uint64_t halve(uint64_t word) {
+    word = (word | (word >> 1)) & 0x5555555555555555ULL;
+    word = (word | (word >> 1)) & 0x3333333333333333ULL;
+    word = (word | (word >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+    word = (word | (word >> 4)) & 0x00FF00FF00FF00FFULL;
+    word = (word | (word >> 8)) & 0x0000FFFF0000FFFFULL;
+    return (word | (word >> 16)) & 0x00000000FFFFFFFFULL;
+}
+
+// 64 cellules vivantes de la ligne y à partir de la colonne x (zéro hors de la grille)
+uint64_t cellBits(const Grid& grid, int64_t y, int64_t x) {
+    if (y < 0 || y >= grid.getHeight() || x >= grid.getWidth() || x <= -Grid::TileSize) {
+        return 0;
+    }
+    int64_t tx = x >= 0 ? x / Grid::TileSize : -1;
+    int shift = static_cast<int>(x - tx * Grid::TileSize);
+    int r = static_cast<int>(y % Grid::TileSize);
+    int rowStart = static_cast<int>(y / Grid::TileSize) * grid.getTilesX();
+    auto word = [&](int64_t t) -> uint64_t {
+        if (t < 0 || t >= grid.getTilesX()) {
+            return 0;
+        }
+        const std::shared_ptr<Grid::Tile>& tile = grid.getSharedTile(rowStart + static_cast<int>(t));
+        if (tile == Grid::emptyTile()) {
+            return 0;
+        }
+        int64_t columns = std::min<int64_t>(Grid::TileSize, grid.getWidth() - t * Grid::TileSize);
+        return tile->alive[r] & (columns == Grid::TileSize ? ~0ULL : (1ULL << columns) - 1);
+    };
+    uint64_t low = word(tx);
+    return shift == 0 ? low : (low >> shift) | (word(tx + 1) << (Grid::TileSize - shift));
+}
+
+void appendGlyph(std::string& buffer, TerminalRenderer::Mode mode, uint8_t code) {
+    if (code == 0) {
+        buffer += ' ';
+    } else if (mode == TerminalRenderer::Braille) {
+        // U+2800 + motif, en UTF-8
+        buffer += static_cast<char>(0xE2);
+        buffer += static_cast<char>(0xA0 | (code >> 6));
+        buffer += static_cast<char>(0x80 | (code & 0x3F));
+    } else {
+        // U+2580 (haut), U+2584 (bas), U+2588 (plein)
+        static const char* const halfBlocks[4] = {" ", "\xE2\x96\x80", "\xE2\x96\x84", "\xE2\x96\x88"};
+        buffer += halfBlocks[code];
+    }
+}
+
+int countTrailingZeros(uint64_t value) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(value);
+#else
+    int count = 0;
+    while (!((value >> count) & 1)) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+}
+
+const char TerminalRenderer::AliveChar;
+const char TerminalRenderer::DeadChar;
+const char TerminalRenderer::ObstacleChar;
+const int TerminalRenderer::MaxZoom;
+
+TerminalRenderer::TerminalRenderer(double maxFramesPerSecond, std::ostream* output)
+    : mode(Cells), viewportX(0), viewportY(0), zoom(1), columns(80), rows(22), output(output),
+      frameInterval(maxFramesPerSecond > 0
+          ? std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / maxFramesPerSecond))
+          : std::chrono::steady_clock::duration::zero()),
+      hasFrame(false), previous(1, 1), lastFrameBytes(0), screenRows(0), layoutChanged(true) {
+#ifdef _WIN32
+    // Séquences ANSI interprétées par la console Windows 10 et suivantes
+    HANDLE output = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+    if (GetConsoleMode(output, &mode)) {
+        SetConsoleMode(output, mode | 0x0004);  // ENABLE_VIRTUAL_TERMINAL_PROCESSING
+    }
+#endif
+}
+
+TerminalRenderer::~TerminalRenderer() {
+    finish();
+}
+
+bool TerminalRenderer::render(const Grid& grid, const std::string& status, bool force) {
+    auto now = std::chrono::steady_clock::now();
+    if (!force && hasFrame && now - lastFrame < frameInterval) {
+        return false;
+    }
+
+    buffer.clear();
+    if (mode != Cells) {
+        int oldColumns = columns;
+        int oldRows = rows;
+        queryTerminalSize();
+        bool full = !hasFrame || layoutChanged || columns != oldColumns || rows != oldRows;
+        if (full) {
+            buffer += "\x1b[?25l\x1b[2J";
+        }
+        if (full || status != previousStatus) {
+            moveTo(1, 1);
+            buffer += status;
+            buffer += "\x1b[K";
+        }
+        computeGlyphs(grid);
+        drawGlyphs(full);
+        flush();
+        previousGlyphs.swap(glyphs);
+        previousStatus = status;
+        screenRows = rows + 1;
+        lastFrame = now;
+        hasFrame = true;
+        layoutChanged = false;
+        return true;
+    }
+
+    bool full = !hasFrame || layoutChanged || grid.getWidth() != previous.getWidth() ||
+                grid.getHeight() != previous.getHeight();
+    if (full) {
+        buffer += "\x1b[?25l\x1b[2J";  // Curseur masqué, écran effacé
+    }
+    if (full || status != previousStatus) {
+        moveTo(1, 1);
+        buffer += status;
+        buffer += "\x1b[K";
+    }
+
+    for (int ty = 0; ty < grid.getTilesY(); ++ty) {
+        // Bande de tuiles toutes partagées avec l'image précédente : rien n'a changé
+        bool changed = full;
+        for (int tx = 0; tx < grid.getTilesX() && !changed; ++tx) {
+            changed = !grid.sharesTile(previous, ty * grid.getTilesX() + tx);
+        }
+        if (!changed) {
+            continue;
+        }
+        int lastRow = std::min(grid.getHeight(), (ty + 1) * Grid::TileSize);
+        for (int y = ty * Grid::TileSize; y < lastRow; ++y) {
+            drawRow(grid, y, full);
+        }
+    }
+
+    flush();
+    previous = grid;
+    previousStatus = status;
+    screenRows = grid.getHeight() + 1;
+    lastFrame = now;
+    hasFrame = true;
+    layoutChanged = false;
+    return true;
+}
+
+void TerminalRenderer::drawRow(const Grid& grid, int y, bool full) {
+    int ty = y / Grid::TileSize;
+    int r = y % Grid::TileSize;
+    int cursor = -1;  // Colonne où se trouve le curseur, -1 si inconnue
+    for (int tx = 0; tx < grid.getTilesX(); ++tx) {
+        int index = ty * grid.getTilesX() + tx;
+        if (!full && grid.sharesTile(previous, index)) {
+            continue;
+        }
+        const Grid::Tile& tile = grid.getTile(index);
+        int columns = std::min(Grid::TileSize, grid.getWidth() - tx * Grid::TileSize);
+        uint64_t valid = columns == Grid::TileSize ? ~0ULL : (1ULL << columns) - 1;
+        uint64_t diff = valid;
+        if (!full) {
+            const Grid::Tile& old = previous.getTile(index);
+            diff &= (tile.alive[r] ^ old.alive[r]) | (tile.obstacle[r] ^ old.obstacle[r]);
+        }
+        for (; diff; diff &= diff - 1) {
+            int bit = countTrailingZeros(diff);
+            int x = tx * Grid::TileSize + bit;
+            if (cursor >= 0 && x > cursor && x - cursor <= MaxGap) {
+                // Petit écart : réécrire les cellules inchangées évite un déplacement
+                for (; cursor < x; ++cursor) {
+                    buffer += cellChar(grid.getTile(ty * grid.getTilesX() + cursor / Grid::TileSize), r,
+                                       cursor % Grid::TileSize);
+                }
+            } else if (cursor != x) {
+                moveTo(y + 2, x + 1);
+            }
+            buffer += cellChar(tile, r, bit);
+            cursor = x + 1;
+        }
+    }
+}
+
+void TerminalRenderer::finish() {
+    if (!hasFrame) {
+        return;
+    }
+    buffer.clear();
+    moveTo(screenRows + 1, 1);
+    buffer += "\x1b[?25h";
+    flush();
+    hasFrame = false;
+}
+
+void TerminalRenderer::setMode(Mode mode) {
+    this->mode = mode;
+    layoutChanged = true;
+}
+
+void TerminalRenderer::setViewport(int64_t x, int64_t y) {
+    viewportX = x;
+    viewportY = y;
+    layoutChanged = true;
+}
+
+void TerminalRenderer::setZoom(int zoom) {
+    int power = 1;
+    while (power < MaxZoom && power * 2 <= zoom) {
+        power *= 2;
+    }
+    this->zoom = power;
+    layoutChanged = true;
+}
+
+int64_t TerminalRenderer::getViewportWidth() const {
+    return static_cast<int64_t>(columns) * (mode == Braille ? 2 : 1) * (mode == Cells ? 1 : zoom);
+}
+
+int64_t TerminalRenderer::getViewportHeight() const {
+    return static_cast<int64_t>(rows) * (mode == Braille ? 4 : mode == HalfBlocks ? 2 : 1) * (mode == Cells ? 1 : zoom);
+}
+
+void TerminalRenderer::fitViewport(const Grid& grid) {
+    queryTerminalSize();
+    viewportX = 0;
+    viewportY = 0;
+    zoom = 1;
+    while (zoom < MaxZoom && (getViewportWidth() < grid.getWidth() || getViewportHeight() < grid.getHeight())) {
+        zoom *= 2;
+    }
+    layoutChanged = true;
+}
+
+bool TerminalRenderer::fitsOnScreen(const Grid& grid) {
+    queryTerminalSize();
+    return grid.getWidth() <= columns && grid.getHeight() <= rows;
+}
+
+void TerminalRenderer::queryTerminalSize() {
+    int width = 80;
+    int height = 24;  // Taille par défaut, et celle d'un flux de sortie choisi
+#ifdef _WIN32
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if (!output && GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info)) {
+        width = info.srWindow.Right - info.srWindow.Left + 1;
+        height = info.srWindow.Bottom - info.srWindow.Top + 1;
+    }
+#else
+    winsize size;
+    if (!output && ::ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_col > 0 && size.ws_row > 0) {
+        width = size.ws_col;
+        height = size.ws_row;
+    }
+#endif
+    // Une ligne pour l'état, une pour le curseur après la dernière image
+    columns = std::max(1, width);
+    rows = std::max(1, height - 2);
+}
+
+void TerminalRenderer::computeGlyphs(const Grid& grid) {
+    const int dotsPerGlyphX = mode == Braille ? 2 : 1;
+    const int dotsPerGlyphY = mode == Braille ? 4 : 2;
+    const size_t words = (static_cast<size_t>(columns) * dotsPerGlyphX + 63) / 64;
+    const size_t bytes = (static_cast<size_t>(columns) * dotsPerGlyphX + 7) / 8;
+    const int glyphsPerByte = 8 / dotsPerGlyphX;
+
+    glyphs.assign(static_cast<size_t>(columns) * rows, 0);
+    dots.resize(words * dotsPerGlyphY);
+    for (int row = 0; row < rows; ++row) {
+        for (int line = 0; line < dotsPerGlyphY; ++line) {
+            int64_t cellY = viewportY + (static_cast<int64_t>(row) * dotsPerGlyphY + line) * zoom;
+            dotRow(grid, cellY, words, dots.data() + line * words);
+        }
+
+        // Un octet de chaque ligne de points donne 4 caractères braille ou 8 demi-blocs
+        uint8_t* out = glyphs.data() + static_cast<size_t>(row) * columns;
+        for (size_t byte = 0; byte < bytes; ++byte) {
+            size_t word = byte / 8;
+            int shift = static_cast<int>(byte % 8) * 8;
+            uint64_t codes = 0;
+            if (mode == Braille) {
+                const BrailleTables& tables = brailleTables();
+                for (int line = 0; line < 4; ++line) {
+                    codes |= tables.rows[line][(dots[line * words + word] >> shift) & 0xFF];
+                }
+            } else {
+                const SpreadTable& table = spreadTable();
+                codes = table.bytes[(dots[word] >> shift) & 0xFF] |
+                        (table.bytes[(dots[words + word] >> shift) & 0xFF] << 1);
+            }
+            size_t first = byte * glyphsPerByte;
+            for (int i = 0; i < glyphsPerByte && first + i < static_cast<size_t>(columns); ++i) {
+                out[first + i] = static_cast<uint8_t>(codes >> (8 * i));
+            }
+        }
+    }
+}
+
+void TerminalRenderer::dotRow(const Grid& grid, int64_t cellY, size_t words, uint64_t* out) const {
+    std::fill(out, out + words, 0);
+    int halvings = 0;
+    while ((1 << halvings) < zoom) {
+        ++halvings;
+    }
+    const int dotsPerWord = Grid::TileSize / zoom;  // Points tirés de 64 cellules
+    int64_t firstY = std::max<int64_t>(cellY, 0);
+    int64_t lastY = std::min<int64_t>(cellY + zoom, grid.getHeight());
+    // Un point est allumé si l'une de ses zoom x zoom cellules est vivante
+    for (int64_t y = firstY; y < lastY; ++y) {
+        for (size_t word = 0; word < words; ++word) {
+            for (int part = 0; part < zoom; ++part) {
+                int64_t x = viewportX + (static_cast<int64_t>(word) * zoom + part) * Grid::TileSize;
+                uint64_t bits = cellBits(grid, y, x);
+                for (int i = 0; i < halvings && bits; ++i) {
+                    bits = halve(bits);
+                }
+                out[word] |= bits << (part * dotsPerWord);
+            }
+        }
+    }
+}
+
+void TerminalRenderer::drawGlyphs(bool full) {
+    for (int row = 0; row < rows; ++row) {
+        const size_t start = static_cast<size_t>(row) * columns;
+        int cursor = -1;
+        for (int column = 0; column < columns; ++column) {
+            if (!full && glyphs[start + column] == previousGlyphs[start + column]) {
+                continue;
+            }
+            if (cursor >= 0 && column - cursor <= MaxGap) {
+                for (; cursor < column; ++cursor) {
+                    appendGlyph(buffer, mode, glyphs[start + cursor]);
+                }
+            } else if (cursor != column) {
+                moveTo(row + 2, column + 1);
+            }
+            appendGlyph(buffer, mode, glyphs[start + column]);
+            cursor = column + 1;
+        }
+    }
+}
+
+void TerminalRenderer::moveTo(int row, int column) {
+    char sequence[32];
+    int length = std::snprintf(sequence, sizeof(sequence), "\x1b[%d;%dH", row, column);
+    buffer.append(sequence, static_cast<size_t>(length));
+}
+
+void TerminalRenderer::flush() {
+    lastFrameBytes = buffer.size();
+    if (output) {
+        output->write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        output->flush();
+        return;
+    }
+    std::cout.flush();  // Messages déjà émis avant l'image
+#ifdef _WIN32
+    std::fwrite(buffer.data(), 1, buffer.size(), stdout);
+    std::fflush(stdout);
+#else
+    const char* data = buffer.data();
+    size_t remaining = buffer.size();
+    while (remaining > 0) {
+        ssize_t written = ::write(STDOUT_FILENO, data, remaining);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            break;  // Terminal fermé : l'image est perdue, la simulation continue
+        }
+        data += written;
+        remaining -= static_cast<size_t>(written);
+    }
+#endif
+}
+
+}
@@ -0,0 +1,104 @@
+// TerminalRenderer.h
+#pragma once
+#include "components/Grid.h"
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace GameOfLife {
+
+// Affichage d'une grille dans un terminal ANSI. Seules les cellules changées
+// depuis l'image précédente sont réécrites (déplacement du curseur puis
+// caractères), en comparant directement les plans de bits ; chaque image est
+// construite dans un tampon unique et envoyée en une seule écriture.
+//
+// Les grandes grilles s'affichent réduites dans une fenêtre de la taille du
+// terminal : un caractère braille couvre 2 x 4 points, un demi-bloc 1 x 2, et
+// un point regroupe zoom x zoom cellules (vivant si l'une d'elles l'est). Les
+// points sont calculés mot par mot sur les plans de bits, les caractères par
+// tables de correspondance.
+class TerminalRenderer {
+public:
+    enum Mode { Cells, HalfBlocks, Braille };
+
+    static const char AliveChar = 'O';
+    static const char DeadChar = '.';
+    static const char ObstacleChar = '#';  // Obstacle mort
+
+    // maxFramesPerSecond : au-delà, les images sont sautées (0 : aucune limite).
+    // Avec output, les images y sont écrites au lieu de la sortie standard, sur
+    // un terminal supposé de 80 x 24 caractères.
+    explicit TerminalRenderer(double maxFramesPerSecond = 60.0, std::ostream* output = nullptr);
+    ~TerminalRenderer();  // Appelle finish()
+
+    TerminalRenderer(const TerminalRenderer&) = delete;
+    TerminalRenderer& operator=(const TerminalRenderer&) = delete;
+
+    // Affiche la grille et la ligne d'état au-dessus ; faux si l'image a été
+    // sautée faute de temps écoulé depuis la précédente (sauf si force)
+    bool render(const Grid& grid, const std::string& status, bool force = false);
+
+    // Replace le curseur sous la dernière image et le réaffiche
+    void finish();
+
+    // Cells : la grille entière, un caractère par cellule
+    void setMode(Mode mode);
+    Mode getMode() const { return mode; }
+
+    // Fenêtre des modes réduits : coin supérieur gauche (en cellules) et
+    // cellules par point de côté, puissance de 2 entre 1 et MaxZoom
+    static const int MaxZoom = 64;
+    void setViewport(int64_t x, int64_t y);
+    void setZoom(int zoom);
+    int64_t getViewportX() const { return viewportX; }
+    int64_t getViewportY() const { return viewportY; }
+    int getZoom() const { return zoom; }
+
+    // Taille de la fenêtre en cellules, selon le terminal, le mode et le zoom
+    int64_t getViewportWidth() const;
+    int64_t getViewportHeight() const;
+
+    // Zoom le plus faible montrant toute la grille, fenêtre à l'origine
+    void fitViewport(const Grid& grid);
+
+    // Vrai si la grille tient dans le terminal à raison d'un caractère par cellule
+    bool fitsOnScreen(const Grid& grid);
+
+    size_t getLastFrameBytes() const { return lastFrameBytes; }
+
+private:
+    Mode mode;
+    int64_t viewportX;
+    int64_t viewportY;
+    int zoom;
+    int columns;          // Taille du terminal (hors ligne d'état)
+    int rows;
+    std::ostream* output;  // nullptr : sortie standard
+
+    std::chrono::steady_clock::duration frameInterval;
+    std::chrono::steady_clock::time_point lastFrame;
+    bool hasFrame;
+    Grid previous;        // Dernière grille affichée (copie des pointeurs de tuiles)
+    std::string previousStatus;
+    std::string buffer;
+    size_t lastFrameBytes;
+    int screenRows;       // Lignes occupées par la dernière image, ligne d'état comprise
+
+    // Modes réduits : un code par caractère (motif braille, ou haut | bas << 1)
+    std::vector<uint8_t> glyphs;
+    std::vector<uint8_t> previousGlyphs;
+    std::vector<uint64_t> dots;  // Lignes de points de la rangée de caractères en cours
+    bool layoutChanged;   // Mode, fenêtre ou terminal modifiés depuis la dernière image
+
+    void queryTerminalSize();
+    void drawRow(const Grid& grid, int y, bool full);
+    void computeGlyphs(const Grid& grid);
+    void dotRow(const Grid& grid, int64_t cellY, size_t words, uint64_t* out) const;
+    void drawGlyphs(bool full);
+    void moveTo(int row, int column);
+    void flush();
+};
+
+}
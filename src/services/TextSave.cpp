@@ -0,0 +1,375 @@
+// TextSave.cpp
+#include "services/TextSave.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define GAMEOFLIFE_TEXTSAVE_SSE2
+#endif
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace GameOfLife {
+namespace TextSave {
+
+namespace {
+
+const size_t MinChunkSize = 1 << 20;  // En deçà, un seul fil suffit
+
+// Projection en lecture seule du fichier complet
+std::shared_ptr<const char> mapFile(const std::string& path, size_t& size) {
+#ifdef _WIN32
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return nullptr;
+    }
+    size = static_cast<size_t>(file.tellg());
+    auto buffer = std::make_shared<std::vector<char>>(size);
+    file.seekg(0);
+    file.read(buffer->data(), static_cast<std::streamsize>(size));
+    if (!file) {
+        return nullptr;
+    }
+    return std::shared_ptr<const char>(buffer, buffer->data());
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    size = static_cast<size_t>(info.st_size);
+    void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        return nullptr;
+    }
+    ::madvise(address, size, MADV_SEQUENTIAL);
+    size_t length = size;
+    return std::shared_ptr<const char>(static_cast<const char*>(address),
+                                       [length](const char* p) { ::munmap(const_cast<char*>(p), length); });
+#endif
+}
+
+bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+#ifdef GAMEOFLIFE_TEXTSAVE_SSE2
+// Bits de rang pair d'un masque de 16 bits, regroupés sur 8 bits
+uint32_t evenBits(uint32_t mask) {
+    mask &= 0x5555;
+    mask = (mask | (mask >> 1)) & 0x3333;
+    mask = (mask | (mask >> 2)) & 0x0F0F;
+    mask = (mask | (mask >> 4)) & 0x00FF;
+    return mask;
+}
+#endif
+
+// Convertit 8 cellules "c c c c c c c c " (16 octets) en 8 bits ;
+// faux si le bloc ne suit pas exactement ce motif
+bool packBlock(const char* p, uint32_t& bits) {
+#ifdef GAMEOFLIFE_TEXTSAVE_SSE2
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    uint32_t ones = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('1'))));
+    uint32_t zeros = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('0'))));
+    uint32_t spaces = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(' '))));
+    if (((ones | zeros) & 0x5555) != 0x5555 || (spaces & 0xAAAA) != 0xAAAA) {
+        return false;
+    }
+    bits = evenBits(ones);
+    return true;
+#else
+    // Même contrôle sur deux mots de 64 bits (4 cellules chacun)
+    bits = 0;
+    for (int half = 0; half < 2; ++half) {
+        uint64_t word = 0;
+        for (int i = 0; i < 8; ++i) {
+            word |= static_cast<uint64_t>(static_cast<uint8_t>(p[8 * half + i])) << (8 * i);
+        }
+        if ((word & 0xFF00FF00FF00FF00ULL) != 0x2000200020002000ULL ||
+            ((word ^ 0x0030003000300030ULL) & 0x00FE00FE00FE00FEULL) != 0) {
+            return false;
+        }
+        uint64_t alive = word & 0x0001000100010001ULL;
+        bits |= static_cast<uint32_t>((alive | (alive >> 15) | (alive >> 30) | (alive >> 45)) & 0xF) << (4 * half);
+    }
+    return true;
+#endif
+}
+
+// Ligne au format exact "c c ... c" : blocs vectoriels puis fin scalaire
+bool parseExact(const char* p, size_t length, int width, uint64_t* row) {
+    if (length != 2 * static_cast<size_t>(width) - 1) {
+        return false;
+    }
+    int x = 0;
+    for (; 2 * static_cast<size_t>(x) + 16 <= length; x += 8) {
+        uint32_t bits;
+        if (!packBlock(p + 2 * x, bits)) {
+            return false;
+        }
+        row[x / Grid::TileSize] |= static_cast<uint64_t>(bits) << (x % Grid::TileSize);
+    }
+    for (; x < width; ++x) {
+        char c = p[2 * x];
+        if ((c != '0' && c != '1') || (x + 1 < width && p[2 * x + 1] != ' ')) {
+            return false;
+        }
+        if (c == '1') {
+            row[x / Grid::TileSize] |= 1ULL << (x % Grid::TileSize);
+        }
+    }
+    return true;
+}
+
+// Analyse d'une rangée (sans le '\n') dans row, mis à zéro par l'appelant
+bool parseRow(const char* p, const char* end, int width, uint64_t* row, std::string& error) {
+    while (end > p && isBlank(end[-1])) {
+        --end;
+    }
+    const size_t words = (static_cast<size_t>(width) + Grid::TileSize - 1) / Grid::TileSize;
+    if (parseExact(p, static_cast<size_t>(end - p), width, row)) {
+        return true;
+    }
+    std::fill(row, row + words, 0);
+
+    // Espacement irrégulier : lecture valeur par valeur
+    int x = 0;
+    while (p < end) {
+        if (isBlank(*p)) {
+            ++p;
+            continue;
+        }
+        const char* start = p;
+        while (p < end && !isBlank(*p)) {
+            ++p;
+        }
+        if (p - start != 1 || (*start != '0' && *start != '1')) {
+            error = "valeur \"" + std::string(start, p) + "\" en colonne " + std::to_string(x + 1) +
+                    " (0 ou 1 attendu)";
+            return false;
+        }
+        if (x == width) {
+            error = "plus de " + std::to_string(width) + " valeurs";
+            return false;
+        }
+        if (*start == '1') {
+            row[x / Grid::TileSize] |= 1ULL << (x % Grid::TileSize);
+        }
+        ++x;
+    }
+    if (x != width) {
+        error = std::to_string(x) + " valeurs au lieu de " + std::to_string(width);
+        return false;
+    }
+    return true;
+}
+
+// Bloc de lignes complètes analysé par un fil
+struct Chunk {
+    const char* begin;
+    const char* end;
+    size_t firstRow;
+    size_t errorRow;
+    std::string error;
+};
+
+size_t countLines(const char* begin, const char* end) {
+    size_t count = 0;
+    while (begin < end) {
+        const void* found = std::memchr(begin, '\n', static_cast<size_t>(end - begin));
+        if (!found) {
+            break;
+        }
+        ++count;
+        begin = static_cast<const char*>(found) + 1;
+    }
+    return count;
+}
+
+void parseChunk(Chunk& chunk, int width, int height, uint64_t* bits, size_t words) {
+    size_t row = chunk.firstRow;
+    for (const char* p = chunk.begin; p < chunk.end; ++row) {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(chunk.end - p)));
+        if (!eol) {
+            eol = chunk.end;
+        }
+        if (row < static_cast<size_t>(height)) {
+            if (!parseRow(p, eol, width, bits + row * words, chunk.error)) {
+                chunk.errorRow = row;
+                return;
+            }
+        } else if (std::find_if(p, eol, [](char c) { return !isBlank(c); }) != eol) {
+            chunk.error = "plus de " + std::to_string(height) + " rangées";
+            chunk.errorRow = row;
+            return;
+        }
+        p = eol + 1;
+    }
+}
+
+void parallelFor(size_t count, const std::function<void(size_t)>& task) {
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < count; ++i) {
+        threads.emplace_back(task, i);
+    }
+    if (count > 0) {
+        task(0);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+bool fail(const std::string& path, size_t line, const std::string& message) {
+    std::cerr << "Erreur de sauvegarde texte (" << path << ", ligne " << line << ") : " << message << std::endl;
+    return false;
+}
+
+}
+
+bool write(const std::string& path, const Grid& grid) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Erreur : Impossible de créer le fichier " << path << std::endl;
+        return false;
+    }
+    file << grid.getHeight() << " " << grid.getWidth() << "\n";
+
+    // Rangée "c c ... c \n" : les espaces sont fixes, seuls les chiffres changent
+    const int width = grid.getWidth();
+    std::string line(2 * static_cast<size_t>(width) + 1, ' ');
+    line.back() = '\n';
+    for (int y = 0; y < grid.getHeight(); ++y) {
+        for (int tx = 0; tx < grid.getTilesX(); ++tx) {
+            uint64_t word = grid.getTile((y / Grid::TileSize) * grid.getTilesX() + tx).alive[y % Grid::TileSize];
+            int limit = std::min(Grid::TileSize, width - tx * Grid::TileSize);
+            for (int bit = 0; bit < limit; ++bit) {
+                line[2 * static_cast<size_t>(tx * Grid::TileSize + bit)] = ((word >> bit) & 1) ? '1' : '0';
+            }
+        }
+        file.write(line.data(), static_cast<std::streamsize>(line.size()));
+    }
+
+    if (!file) {
+        std::cerr << "Erreur : écriture incomplète de " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool read(const std::string& path, Grid& grid) {
+    size_t size = 0;
+    std::shared_ptr<const char> data = mapFile(path, size);
+    if (!data) {
+        std::cerr << "Erreur lors de l'ouverture du fichier de sauvegarde " << path << std::endl;
+        return false;
+    }
+    const char* begin = data.get();
+    const char* end = begin + size;
+
+    // En-tête "hauteur largeur"
+    const char* headerEnd = static_cast<const char*>(std::memchr(begin, '\n', size));
+    if (!headerEnd) {
+        headerEnd = end;
+    }
+    std::string header(begin, headerEnd);
+    char* next = nullptr;
+    long long height = std::strtoll(header.c_str(), &next, 10);
+    long long width = std::strtoll(next, &next, 10);
+    if (height <= 0 || width <= 0 || height > Grid::MaxDimension || width > Grid::MaxDimension ||
+        std::find_if(static_cast<const char*>(next), header.c_str() + header.size(),
+                     [](char c) { return !isBlank(c); }) != header.c_str() + header.size()) {
+        return fail(path, 1, "en-tête \"hauteur largeur\" invalide");
+    }
+    const size_t words = (static_cast<size_t>(width) + Grid::TileSize - 1) / Grid::TileSize;
+    if (words * ((height + Grid::TileSize - 1) / Grid::TileSize) > INT_MAX / 2) {
+        return fail(path, 1, "grille trop grande");
+    }
+
+    // Découpage en blocs de lignes complètes, un par fil
+    const char* body = std::min(headerEnd + 1, end);
+    size_t threadCount = Grid::getThreadCount();
+    size_t chunkCount = std::max<size_t>(1, std::min(threadCount, static_cast<size_t>(end - body) / MinChunkSize));
+    std::vector<Chunk> chunks(chunkCount);
+    for (size_t i = 0; i < chunkCount; ++i) {
+        const char* start = body + static_cast<size_t>(end - body) * i / chunkCount;
+        if (i > 0) {
+            const char* eol = static_cast<const char*>(std::memchr(start, '\n', static_cast<size_t>(end - start)));
+            start = std::max(chunks[i - 1].begin, eol ? eol + 1 : end);
+            chunks[i - 1].end = start;
+        }
+        chunks[i].begin = start;
+        chunks[i].end = end;
+    }
+
+    // Numéro de la première rangée de chaque bloc
+    std::vector<size_t> lineCounts(chunkCount);
+    parallelFor(chunkCount, [&](size_t i) { lineCounts[i] = countLines(chunks[i].begin, chunks[i].end); });
+    size_t rows = 0;
+    for (size_t i = 0; i < chunkCount; ++i) {
+        chunks[i].firstRow = rows;
+        rows += lineCounts[i];
+    }
+    if (body < end && end[-1] != '\n') {
+        ++rows;
+    }
+    if (rows < static_cast<size_t>(height)) {
+        return fail(path, rows + 2, std::to_string(height) + " rangées attendues, " + std::to_string(rows) + " trouvées");
+    }
+
+    std::vector<uint64_t> bits(static_cast<size_t>(height) * words, 0);
+    parallelFor(chunkCount, [&](size_t i) {
+        chunks[i].errorRow = SIZE_MAX;
+        parseChunk(chunks[i], static_cast<int>(width), static_cast<int>(height), bits.data(), words);
+    });
+    for (const Chunk& chunk : chunks) {
+        if (chunk.errorRow != SIZE_MAX) {
+            return fail(path, chunk.errorRow + 2, chunk.error);
+        }
+    }
+
+    // Rangées de bits -> tuiles ; les tuiles vides restent partagées
+    Grid loaded(static_cast<int>(width), static_cast<int>(height));
+    for (int ty = 0; ty < loaded.getTilesY(); ++ty) {
+        int rowCount = std::min(Grid::TileSize, static_cast<int>(height) - ty * Grid::TileSize);
+        for (int tx = 0; tx < loaded.getTilesX(); ++tx) {
+            const uint64_t* first = bits.data() + static_cast<size_t>(ty) * Grid::TileSize * words + tx;
+            bool empty = true;
+            for (int r = 0; r < rowCount && empty; ++r) {
+                empty = first[r * words] == 0;
+            }
+            if (empty) {
+                continue;
+            }
+            Grid::Tile& tile = loaded.getMutableTile(ty * loaded.getTilesX() + tx);
+            for (int r = 0; r < rowCount; ++r) {
+                tile.alive[r] = first[r * words];
+            }
+        }
+    }
+
+    grid = std::move(loaded);
+    return true;
+}
+
+}
+}
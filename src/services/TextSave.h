@@ -0,0 +1,25 @@
+// TextSave.h
+#pragma once
+#include "components/Grid.h"
+#include <string>
+
+namespace GameOfLife {
+
+// Sauvegardes texte historiques (extension .txt) :
+//   hauteur largeur
+//   0 1 0 ...        une ligne par rangée, 1 pour une cellule vivante
+// Le fichier est projeté en mémoire, découpé en blocs de lignes analysés en
+// parallèle ; chaque ligne est validée et convertie en mots de 64 bits par
+// comparaisons vectorielles d'octets.
+namespace TextSave {
+
+const char Extension[] = ".txt";
+
+bool write(const std::string& path, const Grid& grid);
+
+// Les erreurs indiquent la ligne fautive ; grid n'est modifiée qu'en cas de succès
+bool read(const std::string& path, Grid& grid);
+
+}
+
+}
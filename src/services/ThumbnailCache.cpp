@@ -0,0 +1,243 @@
+// ThumbnailCache.cpp
+#include "services/ThumbnailCache.h"
+#include "services/SaveQueue.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace GameOfLife {
+
+namespace {
+
+const char ThumbnailDirectory[] = ".thumbs/";
+
+int countTrailingZeros(uint64_t value) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(value);
+#else
+    int count = 0;
+    while (!((value >> count) & 1)) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+int popcount(uint64_t value) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(value);
+#else
+    int count = 0;
+    for (; value; value &= value - 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+uint8_t shade(uint64_t alive, uint64_t cells) {
+    return alive == 0 ? 0 : (alive == cells ? ThumbnailCache::Full : ThumbnailCache::Partial);
+}
+
+// Pixels d'un sous-arbre ; un pixel couvre 2^pixelLevel cellules de côté
+void paint(const Quadtree& tree, uint32_t id, int level, int pixelLevel,
+           int px, int py, ThumbnailCache::Image& image) {
+    if (id == Quadtree::Empty) {
+        return;
+    }
+    if (level == pixelLevel) {
+        uint64_t cells = level <= 31 ? 1ULL << (2 * level) : UINT64_MAX;
+        image.pixels[static_cast<size_t>(py) * image.width + px] =
+            level <= 31 && tree.populationOf(id) == cells ? ThumbnailCache::Full : ThumbnailCache::Partial;
+        return;
+    }
+    if (level == Quadtree::LeafLevel) {
+        // Pixel plus petit qu'une feuille : blocs de bits de la feuille
+        int block = 1 << pixelLevel;
+        uint64_t bits = tree.leafBits(id);
+        uint64_t rowMask = (1ULL << block) - 1;
+        for (int by = 0; by < 8 / block; ++by) {
+            for (int bx = 0; bx < 8 / block; ++bx) {
+                uint64_t alive = 0;
+                for (int r = 0; r < block; ++r) {
+                    alive += popcount((bits >> ((by * block + r) * 8 + bx * block)) & rowMask);
+                }
+                image.pixels[static_cast<size_t>(py + by) * image.width + px + bx] =
+                    shade(alive, static_cast<uint64_t>(block) * block);
+            }
+        }
+        return;
+    }
+    int half = 1 << (level - 1 - pixelLevel);
+    const uint32_t* children = tree.childrenOf(id);
+    paint(tree, children[0], level - 1, pixelLevel, px, py, image);
+    paint(tree, children[1], level - 1, pixelLevel, px + half, py, image);
+    paint(tree, children[2], level - 1, pixelLevel, px, py + half, image);
+    paint(tree, children[3], level - 1, pixelLevel, px + half, py + half, image);
+}
+
+bool readPgm(const std::string& path, ThumbnailCache::Image& image) {
+    std::ifstream file(path, std::ios::binary);
+    std::string magic;
+    int maxValue = 0;
+    if (!(file >> magic >> image.width >> image.height >> maxValue) || magic != "P5" || maxValue != 255 ||
+        image.width <= 0 || image.height <= 0 || image.width > ThumbnailCache::Size ||
+        image.height > ThumbnailCache::Size) {
+        return false;
+    }
+    file.get();  // Séparateur unique avant les pixels
+    image.pixels.resize(static_cast<size_t>(image.width) * image.height);
+    file.read(reinterpret_cast<char*>(image.pixels.data()), static_cast<std::streamsize>(image.pixels.size()));
+    return static_cast<bool>(file);
+}
+
+bool writePgm(const std::string& path, const ThumbnailCache::Image& image) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << "P5\n" << image.width << " " << image.height << "\n255\n";
+    file.write(reinterpret_cast<const char*>(image.pixels.data()), static_cast<std::streamsize>(image.pixels.size()));
+    return static_cast<bool>(file);
+}
+
+}
+
+ThumbnailCache::ThumbnailCache(const std::string& directory) : directory(directory), stopping(false) {
+    if (!this->directory.empty() && this->directory.back() != '/') {
+        this->directory += '/';
+    }
+}
+
+ThumbnailCache::~ThumbnailCache() {
+    if (!worker.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        requests.clear();
+    }
+    wake.notify_all();
+    worker.join();
+}
+
+std::shared_ptr<const ThumbnailCache::Image> ThumbnailCache::find(const SaveIndex::Entry& entry) {
+    if (!entry.readable) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = ready.find(entry.hash);
+    if (found != ready.end()) {
+        return found->second;
+    }
+    // Une demande par empreinte, y compris pour les fichiers illisibles
+    if (requested.insert(entry.hash).second) {
+        requests.push_back(Request{entry.name, entry.hash});
+        if (!worker.joinable()) {
+            worker = std::thread(&ThumbnailCache::run, this);
+        }
+        wake.notify_one();
+    }
+    return nullptr;
+}
+
+void ThumbnailCache::cancelPending() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const Request& request : requests) {
+        requested.erase(request.hash);
+    }
+    requests.clear();
+}
+
+ThumbnailCache::Image ThumbnailCache::fromGrid(const Grid& grid) {
+    // Blocs carrés de scale x scale cellules, l'image garde les proportions
+    const int64_t scale = std::max<int64_t>(1, (std::max(grid.getWidth(), grid.getHeight()) + Size - 1) / Size);
+    Image image;
+    image.width = static_cast<int>((grid.getWidth() + scale - 1) / scale);
+    image.height = static_cast<int>((grid.getHeight() + scale - 1) / scale);
+    std::vector<uint64_t> alive(static_cast<size_t>(image.width) * image.height, 0);
+
+    for (int t = 0; t < grid.getTileCount(); ++t) {
+        if (grid.getSharedTile(t) == Grid::emptyTile()) {
+            continue;
+        }
+        const Grid::Tile& tile = grid.getTile(t);
+        int x0 = (t % grid.getTilesX()) * Grid::TileSize;
+        int y0 = (t / grid.getTilesX()) * Grid::TileSize;
+        for (int r = 0; r < Grid::TileSize && y0 + r < grid.getHeight(); ++r) {
+            uint64_t* row = alive.data() + static_cast<size_t>((y0 + r) / scale) * image.width;
+            for (uint64_t word = tile.alive[r]; word; word &= word - 1) {
+                ++row[(x0 + countTrailingZeros(word)) / scale];
+            }
+        }
+    }
+
+    image.pixels.resize(alive.size());
+    for (int py = 0; py < image.height; ++py) {
+        int64_t rows = std::min<int64_t>(scale, grid.getHeight() - py * scale);
+        for (int px = 0; px < image.width; ++px) {
+            int64_t columns = std::min<int64_t>(scale, grid.getWidth() - px * scale);
+            size_t index = static_cast<size_t>(py) * image.width + px;
+            image.pixels[index] = shade(alive[index], static_cast<uint64_t>(rows * columns));
+        }
+    }
+    return image;
+}
+
+ThumbnailCache::Image ThumbnailCache::fromPattern(const Quadtree& tree) {
+    // Le parcours s'arrête au niveau d'un pixel : le motif n'est jamais déplié
+    int level = tree.getRootLevel();
+    int pixelLevel = std::max(0, level - 6);
+    Image image;
+    image.width = image.height = 1 << (level - pixelLevel);
+    image.pixels.assign(static_cast<size_t>(image.width) * image.height, 0);
+    paint(tree, tree.getRoot(), level, pixelLevel, 0, 0, image);
+    return image;
+}
+
+void ThumbnailCache::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this] { return stopping || !requests.empty(); });
+        if (stopping) {
+            break;
+        }
+        Request request = requests.front();
+        requests.pop_front();
+        lock.unlock();
+        std::shared_ptr<const Image> image = produce(request);
+        lock.lock();
+        if (image) {
+            ready[request.hash] = image;
+        }
+    }
+}
+
+std::shared_ptr<const ThumbnailCache::Image> ThumbnailCache::produce(const Request& request) const {
+    auto image = std::make_shared<Image>();
+    std::string path = cachePath(request.hash);
+    if (readPgm(path, *image)) {
+        return image;
+    }
+
+    Grid grid(1, 1);
+    Quadtree tree;
+    uint64_t generation = 0;
+    bool isPattern = false;
+    if (!SaveIndex::readSave(directory + request.name, grid, tree, generation, isPattern)) {
+        return nullptr;
+    }
+    *image = isPattern ? fromPattern(tree) : fromGrid(grid);
+
+    std::error_code error;
+    std::filesystem::create_directories(directory + ThumbnailDirectory, error);
+    SaveQueue::writeAtomically(path, [&](const std::string& temporary) { return writePgm(temporary, *image); });
+    return image;
+}
+
+std::string ThumbnailCache::cachePath(uint64_t hash) const {
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hash));
+    return directory + ThumbnailDirectory + name + ".pgm";
+}
+
+}
@@ -0,0 +1,72 @@
+// ThumbnailCache.h
+#pragma once
+#include "components/Grid.h"
+#include "components/Quadtree.h"
+#include "services/SaveIndex.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace GameOfLife {
+
+// Miniatures des sauvegardes, calculées par un thread d'arrière-plan et
+// conservées dans le sous-répertoire ".thumbs" (une image PGM par empreinte
+// de contenu : un fichier modifié obtient une nouvelle miniature).
+// Chaque pixel résume un bloc de cellules : 0 s'il est vide, Full s'il est
+// entièrement vivant, Partial sinon (le maximum garde les cellules isolées
+// visibles, le minimum distingue les zones pleines).
+class ThumbnailCache {
+public:
+    static const int Size = 64;
+    static const uint8_t Partial = 160;
+    static const uint8_t Full = 255;
+
+    struct Image {
+        int width;
+        int height;
+        std::vector<uint8_t> pixels;  // Niveaux de gris, ligne par ligne
+    };
+
+    explicit ThumbnailCache(const std::string& directory);
+    ~ThumbnailCache();
+
+    ThumbnailCache(const ThumbnailCache&) = delete;
+    ThumbnailCache& operator=(const ThumbnailCache&) = delete;
+
+    // Ne bloque jamais : la miniature si elle est prête, sinon nullptr
+    // (et sa génération est demandée)
+    std::shared_ptr<const Image> find(const SaveIndex::Entry& entry);
+
+    // Abandonne les demandes pas encore traitées (changement de page)
+    void cancelPending();
+
+    static Image fromGrid(const Grid& grid);
+    static Image fromPattern(const Quadtree& tree);
+
+private:
+    struct Request {
+        std::string name;
+        uint64_t hash;
+    };
+
+    std::string directory;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<Request> requests;
+    std::unordered_set<uint64_t> requested;
+    std::unordered_map<uint64_t, std::shared_ptr<const Image>> ready;
+    std::thread worker;  // Démarré à la première demande
+    bool stopping;
+
+    void run();
+    std::shared_ptr<const Image> produce(const Request& request) const;
+    std::string cachePath(uint64_t hash) const;
+};
+
+}
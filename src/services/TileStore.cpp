@@ -0,0 +1,108 @@
+// TileStore.cpp
+#include "services/TileStore.h"
+#include <cstring>
+
+namespace GameOfLife {
+
+namespace {
+
+const size_t MinPurgeThreshold = 1024;
+
+uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+}
+
+TileStore::TileStore() : purgeThreshold(MinPurgeThreshold) {
+}
+
+TileStore::Hash TileStore::hashTile(const Grid::Tile& tile) {
+    // Deux accumulateurs indépendants sur les 3 plans de la tuile
+    const uint64_t* words = tile.alive;
+    const int count = static_cast<int>(sizeof(Grid::Tile) / sizeof(uint64_t));
+    uint64_t a = 0x9E3779B97F4A7C15ULL;
+    uint64_t b = 0xC2B2AE3D27D4EB4FULL;
+    for (int i = 0; i < count; ++i) {
+        a = (a ^ words[i]) * 0x100000001B3ULL;
+        a ^= a >> 29;
+        b = (b + words[i] + static_cast<uint64_t>(i)) * 0xFF51AFD7ED558CCDULL;
+        b = (b << 31) | (b >> 33);
+    }
+    return Hash{mix(a ^ b), mix(b + a * 3)};
+}
+
+bool TileStore::isEmpty(const Grid::Tile& tile) {
+    const uint64_t* words = tile.alive;
+    const int count = static_cast<int>(sizeof(Grid::Tile) / sizeof(uint64_t));
+    uint64_t any = 0;
+    for (int i = 0; i < count; ++i) {
+        any |= words[i];
+    }
+    return any == 0;
+}
+
+int TileStore::intern(Grid& grid, const Grid* previous) {
+    bool comparable = previous && previous->getWidth() == grid.getWidth() &&
+                      previous->getHeight() == grid.getHeight();
+    const std::shared_ptr<Grid::Tile>& empty = Grid::emptyTile();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    int added = 0;
+    for (int i = 0; i < grid.getTileCount(); ++i) {
+        const std::shared_ptr<Grid::Tile>& tile = grid.getSharedTile(i);
+        if (tile == empty || (comparable && grid.sharesTile(*previous, i))) {
+            continue;
+        }
+        if (isEmpty(*tile)) {
+            grid.setSharedTile(i, empty);
+            continue;
+        }
+
+        std::weak_ptr<Grid::Tile>& entry = tiles[hashTile(*tile)];
+        std::shared_ptr<Grid::Tile> canonical = entry.lock();
+        if (canonical == tile) {
+            continue;
+        }
+        // Une entrée expirée, modifiée sur place ou en collision est remplacée
+        if (canonical && std::memcmp(canonical.get(), tile.get(), sizeof(Grid::Tile)) == 0) {
+            grid.setSharedTile(i, canonical);
+        } else {
+            entry = tile;
+            ++added;
+        }
+    }
+
+    if (tiles.size() > purgeThreshold) {
+        purge();
+    }
+    return added;
+}
+
+size_t TileStore::uniqueTiles() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    purge();
+    return tiles.size();
+}
+
+size_t TileStore::storedBytes() const {
+    return uniqueTiles() * sizeof(Grid::Tile);
+}
+
+void TileStore::purge() const {
+    for (auto it = tiles.begin(); it != tiles.end();) {
+        if (it->second.expired()) {
+            it = tiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    purgeThreshold = tiles.size() * 2 > MinPurgeThreshold ? tiles.size() * 2 : MinPurgeThreshold;
+}
+
+}
@@ -0,0 +1,54 @@
+// TileStore.h
+#pragma once
+#include "components/Grid.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace GameOfLife {
+
+// Magasin de tuiles adressé par contenu (empreinte de 128 bits) : les tuiles
+// identiques (espace vide, natures mortes, phases d'oscillateurs) ne sont
+// conservées qu'une fois. Le magasin ne retient pas les tuiles : une entrée
+// disparaît dès qu'aucune grille ne la référence plus.
+class TileStore {
+public:
+    struct Hash {
+        uint64_t low;
+        uint64_t high;
+
+        bool operator==(const Hash& other) const {
+            return low == other.low && high == other.high;
+        }
+    };
+
+    struct Hasher {
+        size_t operator()(const Hash& hash) const {
+            return static_cast<size_t>(hash.low ^ (hash.high >> 7));
+        }
+    };
+
+    TileStore();
+
+    static Hash hashTile(const Grid::Tile& tile);
+    static bool isEmpty(const Grid::Tile& tile);
+
+    // Remplace les tuiles de grid par leur exemplaire canonique. Les tuiles
+    // partagées avec previous (déjà canoniques) ne sont pas relues.
+    // Retourne le nombre de tuiles ajoutées au magasin.
+    int intern(Grid& grid, const Grid* previous = nullptr);
+
+    size_t uniqueTiles() const;    // Tuiles distinctes encore référencées
+    size_t storedBytes() const;
+
+private:
+    mutable std::mutex mutex;
+    mutable std::unordered_map<Hash, std::weak_ptr<Grid::Tile>, Hasher> tiles;
+    mutable size_t purgeThreshold;  // Taille de table déclenchant un nettoyage
+
+    void purge() const;
+};
+
+}
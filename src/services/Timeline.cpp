@@ -0,0 +1,506 @@
+// Timeline.cpp
+#include "services/Timeline.h"
+#include "services/DeltaCodec.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+namespace GameOfLife {
+
+Timeline::Timeline(int keyframeInterval, size_t memoryBudget)
+    : selected(npos), nextId(0), useClock(0), cacheNode(npos),
+      keyframeInterval(keyframeInterval > 0 ? keyframeInterval : 1),
+      memoryBudget(memoryBudget), nodesBytes(0), spillEnabled(true), spillLogicalBytes(0) {
+}
+
+size_t Timeline::addChild(size_t parent, Grid& grid) {
+    if (!contains(parent)) {
+        parent = npos;
+    }
+
+    Node n;
+    n.parent = parent;
+    n.depth = parent == npos ? 0 : nodes.at(parent).depth + 1;
+    n.activeChild = npos;
+    n.lastUse = 0;
+    n.width = grid.getWidth();
+    n.height = grid.getHeight();
+    n.toroidal = grid.isToroidal();
+    n.keyframe = false;
+    n.keyBytes = 0;
+    n.hasDelta = false;
+    n.spilled = false;
+    n.spillOffset = 0;
+    n.spillDeltaSize = 0;
+    n.spillKeySize = 0;
+
+    if (parent == npos) {
+        // Variante de l'état initial : identique à une racine existante ?
+        for (size_t other : roots) {
+            const Node& r = nodes.at(other);
+            if (r.width == n.width && r.height == n.height && r.toroidal == n.toroidal &&
+                DeltaCodec::encodeXor(keyOf(r), grid).empty()) {
+                select(other);
+                return other;
+            }
+        }
+    } else {
+        Node& p = nodes.at(parent);
+        if (p.width == n.width && p.height == n.height) {
+            if (cacheNode == parent && cacheGrid) {
+                n.delta = DeltaCodec::encodeXor(*cacheGrid, grid);
+            } else {
+                n.delta = DeltaCodec::encodeXor(materialize(parent), grid);
+            }
+            n.delta.shrink_to_fit();
+            n.hasDelta = true;
+
+            // Même état déjà exploré depuis ce parent : réutiliser la branche
+            std::vector<uint8_t> buffer;
+            for (size_t child : p.children) {
+                const Node& c = nodes.at(child);
+                if (c.hasDelta && c.toroidal == n.toroidal && deltaOf(c, buffer) == n.delta) {
+                    cacheNode = child;
+                    cacheGrid.reset(new Grid(grid));
+                    select(child);
+                    return child;
+                }
+            }
+        }
+    }
+
+    // Une image clé est forcée à la racine et à chaque changement de taille
+    if (!n.hasDelta || n.depth % keyframeInterval == 0) {
+        makeKeyframe(n, grid);
+    }
+
+    size_t id = nextId++;
+    nodesBytes += nodeBytes(n);
+    nodes.emplace(id, std::move(n));
+    if (parent == npos) {
+        roots.push_back(id);
+    } else {
+        nodes.at(parent).children.push_back(id);
+    }
+
+    cacheNode = id;
+    cacheGrid.reset(new Grid(grid));
+    select(id);
+    evict();
+    return id;
+}
+
+bool Timeline::load(size_t node, Grid& grid, size_t from) const {
+    if (!contains(node)) {
+        return false;
+    }
+
+    if (from != npos && from != node && contains(from)) {
+        // Chemin from -> ancêtre commun -> node, comparé au chemin depuis l'image clé
+        size_t common = commonAncestor(from, node);
+        const Node& target = nodes.at(node);
+        // Deux racines distinctes n'ont pas d'ancêtre commun
+        bool walkable = common != npos;
+        if (walkable) {
+            size_t pathLength = nodes.at(from).depth + target.depth - 2 * nodes.at(common).depth;
+            size_t keyLength = target.depth - nodes.at(keyframeAncestor(node)).depth;
+            walkable = pathLength <= keyLength;
+        }
+        for (size_t x = from; walkable && x != common; x = nodes.at(x).parent) {
+            walkable = nodes.at(x).hasDelta;
+        }
+        for (size_t x = node; walkable && x != common; x = nodes.at(x).parent) {
+            walkable = nodes.at(x).hasDelta;
+        }
+
+        if (walkable) {
+            // Le XOR est commutatif et son propre inverse : l'ordre importe peu
+            std::vector<uint8_t> buffer;
+            for (size_t x = from; x != common; x = nodes.at(x).parent) {
+                DeltaCodec::applyXor(deltaOf(nodes.at(x), buffer), grid);
+            }
+            for (size_t x = node; x != common; x = nodes.at(x).parent) {
+                DeltaCodec::applyXor(deltaOf(nodes.at(x), buffer), grid);
+            }
+            grid.setToroidal(target.toroidal);
+            grid.markAllActive();
+            return true;
+        }
+    }
+
+    // La règle est un réglage de la partie, pas un état de l'historique
+    uint16_t birth = grid.getBirthMask();
+    uint16_t survival = grid.getSurvivalMask();
+    grid = materialize(node);
+    grid.setRule(birth, survival);
+    return true;
+}
+
+void Timeline::select(size_t node) {
+    if (!contains(node)) {
+        return;
+    }
+    selected = node;
+    nodes.at(node).lastUse = ++useClock;
+    // Le redo depuis chaque ancêtre suivra désormais cette branche
+    for (size_t child = node, parent = nodes.at(node).parent; parent != npos;
+         child = parent, parent = nodes.at(parent).parent) {
+        nodes.at(parent).activeChild = child;
+    }
+}
+
+void Timeline::clear() {
+    nodes.clear();
+    roots.clear();
+    selected = npos;
+    cacheNode = npos;
+    cacheGrid.reset();
+    nodesBytes = 0;
+    spill.reset();
+    spilledTiles.clear();
+    spillLogicalBytes = 0;
+}
+
+bool Timeline::empty() const {
+    return nodes.empty();
+}
+
+bool Timeline::contains(size_t node) const {
+    return nodes.find(node) != nodes.end();
+}
+
+size_t Timeline::root() const {
+    size_t node = selected;
+    while (parentOf(node) != npos) {
+        node = parentOf(node);
+    }
+    return node;
+}
+
+size_t Timeline::parentOf(size_t node) const {
+    return contains(node) ? nodes.at(node).parent : npos;
+}
+
+size_t Timeline::depthOf(size_t node) const {
+    return contains(node) ? nodes.at(node).depth : 0;
+}
+
+size_t Timeline::activeChildOf(size_t node) const {
+    return contains(node) ? nodes.at(node).activeChild : npos;
+}
+
+const std::vector<size_t>& Timeline::childrenOf(size_t node) const {
+    static const std::vector<size_t> none;
+    if (node == npos) {
+        return roots;
+    }
+    return contains(node) ? nodes.at(node).children : none;
+}
+
+size_t Timeline::ancestorAt(size_t node, size_t depth) const {
+    while (node != npos && nodes.at(node).depth > depth) {
+        node = nodes.at(node).parent;
+    }
+    return node;
+}
+
+size_t Timeline::tipOf(size_t node) const {
+    while (contains(node) && nodes.at(node).activeChild != npos) {
+        node = nodes.at(node).activeChild;
+    }
+    return node;
+}
+
+void Timeline::setMemoryBudget(size_t bytes) {
+    memoryBudget = bytes;
+    evict();
+}
+
+size_t Timeline::getMemoryBudget() const {
+    return memoryBudget;
+}
+
+size_t Timeline::memoryUsage() const {
+    return nodesBytes;
+}
+
+void Timeline::setSpillEnabled(bool enabled) {
+    spillEnabled = enabled;
+    evict();
+}
+
+bool Timeline::isSpillEnabled() const {
+    return spillEnabled;
+}
+
+size_t Timeline::spillUsage() const {
+    return static_cast<size_t>(spill.size());
+}
+
+size_t Timeline::logicalUsage() const {
+    // Taille qu'occuperait l'historique sans partage de tuiles
+    size_t bytes = 0;
+    for (const auto& entry : nodes) {
+        const Node& n = entry.second;
+        bytes += sizeof(Node) + n.children.capacity() * sizeof(size_t) + n.delta.size();
+        if (n.key) {
+            bytes += sizeof(Grid) + n.key->getTileCount() * sizeof(void*) * 2 +
+                     countTiles(*n.key) * sizeof(Grid::Tile);
+        }
+    }
+    return bytes;
+}
+
+size_t Timeline::spillLogicalUsage() const {
+    return spillLogicalBytes;
+}
+
+TileStore& Timeline::tileStore() {
+    return tiles;
+}
+
+Grid Timeline::materialize(size_t node) const {
+    // Repartir de l'image clé la plus proche, puis rejouer les deltas
+    size_t key = keyframeAncestor(node);
+    Grid grid = keyOf(nodes.at(key));
+    std::vector<uint8_t> buffer;
+    for (size_t x = node; x != key; x = nodes.at(x).parent) {
+        DeltaCodec::applyXor(deltaOf(nodes.at(x), buffer), grid);
+    }
+    grid.setToroidal(nodes.at(node).toroidal);
+    // L'état restauré n'est pas forcément issu de la génération qui le précède
+    grid.markAllActive();
+    return grid;
+}
+
+const std::vector<uint8_t>& Timeline::deltaOf(const Node& n, std::vector<uint8_t>& buffer) const {
+    if (!n.spilled) {
+        return n.delta;
+    }
+    if (!spill.read(n.spillOffset, n.spillDeltaSize, buffer)) {
+        std::cerr << "Erreur : relecture impossible de l'historique déchargé" << std::endl;
+        buffer.clear();
+    }
+    return buffer;
+}
+
+Grid Timeline::keyOf(const Node& n) const {
+    if (n.key) {
+        return *n.key;
+    }
+    // Image clé déchargée : liste (écart d'index, position) des tuiles non vides
+    Grid grid(n.width, n.height);
+    std::vector<uint8_t> refs, tile;
+    bool ok = spill.read(n.spillOffset + n.spillDeltaSize, n.spillKeySize, refs);
+    size_t pos = 0;
+    uint64_t index = 0;
+    while (ok && pos < refs.size()) {
+        uint64_t gap, offset;
+        ok = DeltaCodec::readVarint(refs, pos, gap) && DeltaCodec::readVarint(refs, pos, offset);
+        index += gap;
+        ok = ok && index < static_cast<uint64_t>(grid.getTileCount()) &&
+             spill.read(offset, sizeof(Grid::Tile), tile);
+        if (ok) {
+            std::memcpy(&grid.getMutableTile(static_cast<int>(index)), tile.data(), sizeof(Grid::Tile));
+        }
+    }
+    if (!ok) {
+        std::cerr << "Erreur : relecture impossible de l'historique déchargé" << std::endl;
+    }
+    grid.setToroidal(n.toroidal);
+    return grid;
+}
+
+void Timeline::spillNode(Node& n) {
+    nodesBytes -= nodeBytes(n);
+    std::vector<uint8_t> data;
+    data.swap(n.delta);
+    n.spillDeltaSize = data.size();
+    n.spillKeySize = 0;
+    spillLogicalBytes += data.size();
+    if (n.key) {
+        // Les tuiles déjà présentes dans le fichier ne sont pas réécrites
+        size_t start = data.size();
+        int last = 0;
+        for (int i = 0; i < n.key->getTileCount(); ++i) {
+            if (n.key->getSharedTile(i) == Grid::emptyTile()) {
+                continue;
+            }
+            DeltaCodec::writeVarint(data, static_cast<uint64_t>(i - last));
+            DeltaCodec::writeVarint(data, spillTile(n.key->getTile(i)));
+            spillLogicalBytes += sizeof(Grid::Tile);
+            last = i;
+        }
+        n.spillKeySize = data.size() - start;
+        n.key.reset();
+        n.keyBytes = 0;
+    }
+    n.spillOffset = spill.append(std::move(data));
+    n.spilled = true;
+    nodesBytes += nodeBytes(n);
+}
+
+uint64_t Timeline::spillTile(const Grid::Tile& tile) {
+    TileStore::Hash hash = TileStore::hashTile(tile);
+    auto found = spilledTiles.find(hash);
+    if (found != spilledTiles.end()) {
+        return found->second;
+    }
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&tile);
+    uint64_t offset = spill.append(std::vector<uint8_t>(bytes, bytes + sizeof(Grid::Tile)));
+    spilledTiles.emplace(hash, offset);
+    return offset;
+}
+
+size_t Timeline::countTiles(const Grid& grid) {
+    size_t count = 0;
+    for (int i = 0; i < grid.getTileCount(); ++i) {
+        if (grid.getSharedTile(i) != Grid::emptyTile()) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+size_t Timeline::keyframeAncestor(size_t node) const {
+    while (!nodes.at(node).keyframe) {
+        node = nodes.at(node).parent;
+    }
+    return node;
+}
+
+size_t Timeline::commonAncestor(size_t a, size_t b) const {
+    // npos si les deux nœuds ne descendent pas de la même racine
+    while (a != npos && b != npos && a != b) {
+        if (nodes.at(a).depth >= nodes.at(b).depth) {
+            a = nodes.at(a).parent;
+        } else {
+            b = nodes.at(b).parent;
+        }
+    }
+    return a == b ? a : npos;
+}
+
+void Timeline::makeKeyframe(Node& n, Grid& grid) {
+    // Seules les tuiles absentes du magasin occupent de la mémoire : la grille
+    // courante adopte les exemplaires partagés pour ne pas les dupliquer
+    const Grid* previous = n.parent != npos ? nodes.at(keyframeAncestor(n.parent)).key.get() : nullptr;
+    int ownTiles = tiles.intern(grid, previous);
+    n.keyframe = true;
+    n.key.reset(new Grid(grid));
+    n.keyBytes = sizeof(Grid) + grid.getTileCount() * sizeof(void*) * 2 + ownTiles * sizeof(Grid::Tile);
+}
+
+size_t Timeline::nodeBytes(const Node& n) {
+    return sizeof(Node) + n.children.capacity() * sizeof(size_t) + n.keyBytes + n.delta.size();
+}
+
+void Timeline::removeNode(size_t id) {
+    Node& n = nodes.at(id);
+    if (n.parent == npos) {
+        for (size_t i = 0; i < roots.size(); ++i) {
+            if (roots[i] == id) {
+                roots.erase(roots.begin() + i);
+                break;
+            }
+        }
+    } else {
+        Node& p = nodes.at(n.parent);
+        nodesBytes -= nodeBytes(p);
+        for (size_t i = 0; i < p.children.size(); ++i) {
+            if (p.children[i] == id) {
+                p.children.erase(p.children.begin() + i);
+                break;
+            }
+        }
+        if (p.activeChild == id) {
+            p.activeChild = p.children.empty() ? npos : p.children.back();
+        }
+        nodesBytes += nodeBytes(p);
+    }
+    nodesBytes -= nodeBytes(n);
+    if (cacheNode == id) {
+        cacheNode = npos;
+        cacheGrid.reset();
+    }
+    nodes.erase(id);
+}
+
+void Timeline::evict() {
+    if (nodesBytes <= memoryBudget) {
+        return;
+    }
+
+    // 1. Décharger sur disque les données des nœuds les moins récemment visités
+    if (spillEnabled && !spill.isOpen() && !spill.open()) {
+        spillEnabled = false;
+    }
+    if (spillEnabled && spill.good()) {
+        size_t selectedParent = parentOf(selected);
+        std::vector<std::pair<uint64_t, size_t>> candidates;
+        for (const auto& entry : nodes) {
+            const Node& n = entry.second;
+            if (!n.spilled && (n.key || !n.delta.empty()) &&
+                entry.first != selected && entry.first != selectedParent) {
+                candidates.emplace_back(n.lastUse, entry.first);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end());
+        for (const auto& candidate : candidates) {
+            if (nodesBytes <= memoryBudget) {
+                return;
+            }
+            spillNode(nodes.at(candidate.second));
+        }
+    }
+
+    // 2. Supprimer des nœuds si la structure de l'arbre dépasse encore le budget
+    while (nodesBytes > memoryBudget && nodes.size() > 1) {
+        // Le nœud courant et son parent ne sont jamais supprimés
+        size_t selectedParent = parentOf(selected);
+
+        // Raccourcir le tronc commun jusqu'à l'image clé suivante
+        size_t next = roots.size() == 1 ? roots.front() : npos;
+        bool removable = next != npos;
+        while (removable) {
+            removable = next != selected && next != selectedParent && nodes.at(next).children.size() == 1;
+            next = removable ? nodes.at(next).children.front() : npos;
+            if (removable && nodes.at(next).keyframe) {
+                break;
+            }
+        }
+
+        if (removable) {
+            while (roots.front() != next) {
+                size_t old = roots.front();
+                size_t child = nodes.at(old).children.front();
+                Node& c = nodes.at(child);
+                nodesBytes -= nodeBytes(c);
+                c.parent = npos;
+                c.hasDelta = false;
+                c.delta.clear();
+                c.delta.shrink_to_fit();
+                nodesBytes += nodeBytes(c);
+                removeNode(old);
+                roots.push_back(child);
+            }
+            continue;
+        }
+
+        // Sinon, supprimer la feuille la moins récemment visitée
+        size_t victim = npos;
+        for (const auto& entry : nodes) {
+            if (entry.second.children.empty() && entry.first != selected &&
+                (victim == npos || entry.second.lastUse < nodes.at(victim).lastUse)) {
+                victim = entry.first;
+            }
+        }
+        if (victim == npos) {
+            return;
+        }
+        removeNode(victim);
+    }
+}
+
+}
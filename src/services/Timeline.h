@@ -0,0 +1,129 @@
+// Timeline.h
+#pragma once
+#include "components/Grid.h"
+#include "services/SpillFile.h"
+#include "services/TileStore.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace GameOfLife {
+
+// Arbre des générations enregistrées. Chaque nœud stocke le delta XOR
+// compressé avec son parent ; une image clé (copie de grille partageant ses
+// tuiles) est conservée toutes les keyframeInterval générations. Les branches
+// partagent leur préfixe commun : la mémoire ne croît qu'avec la divergence.
+// Au-delà du budget mémoire, les nœuds les moins récemment visités sont
+// déchargés dans un fichier d'échange et relus à la demande.
+class Timeline {
+public:
+    static const size_t DefaultMemoryBudget = 64 * 1024 * 1024;
+    static const int DefaultKeyframeInterval = 32;
+    static const size_t npos = static_cast<size_t>(-1);
+
+    explicit Timeline(int keyframeInterval = DefaultKeyframeInterval,
+                      size_t memoryBudget = DefaultMemoryBudget);
+
+    // Ajoute grid comme enfant de parent (npos : nouvelle racine, les racines
+    // étant les variantes de l'état initial) et retourne son identifiant.
+    // Un enfant identique existant est réutilisé. Les tuiles de grid peuvent
+    // être remplacées par des exemplaires identiques partagés (TileStore).
+    size_t addChild(size_t parent, Grid& grid);
+
+    // Reconstruit le nœud node dans grid. Si grid contient déjà le nœud from,
+    // les deltas du chemin entre les deux sont appliqués en place lorsque
+    // c'est plus court que de repartir de l'image clé.
+    bool load(size_t node, Grid& grid, size_t from = npos) const;
+
+    // Marque node comme position courante : le redo suivra ce chemin
+    void select(size_t node);
+    void clear();
+    bool empty() const;
+
+    bool contains(size_t node) const;
+    size_t root() const;                 // Racine de la branche courante
+    size_t parentOf(size_t node) const;
+    size_t depthOf(size_t node) const;
+    size_t activeChildOf(size_t node) const;
+    const std::vector<size_t>& childrenOf(size_t node) const;  // npos : racines
+    size_t ancestorAt(size_t node, size_t depth) const;
+    size_t tipOf(size_t node) const;     // Extrémité du chemin actif sous node
+
+    void setMemoryBudget(size_t bytes);
+    size_t getMemoryBudget() const;
+    size_t memoryUsage() const;
+
+    // Débordement sur disque (activé par défaut). Désactivé, le dépassement
+    // du budget supprime les nœuds les plus anciens.
+    void setSpillEnabled(bool enabled);
+    bool isSpillEnabled() const;
+    size_t spillUsage() const;
+
+    // Tailles avant déduplication des tuiles (mémoire et fichier d'échange)
+    size_t logicalUsage() const;
+    size_t spillLogicalUsage() const;
+
+    // Magasin de tuiles des images clés, partagé avec l'écriture des sauvegardes
+    TileStore& tileStore();
+
+private:
+    struct Node {
+        size_t parent;
+        size_t depth;
+        std::vector<size_t> children;
+        size_t activeChild;          // Dernier enfant visité (redo)
+        uint64_t lastUse;
+
+        int width;
+        int height;
+        bool toroidal;
+        bool keyframe;
+        std::unique_ptr<Grid> key;   // Image clé (tuiles partagées), nulle si déchargée
+        size_t keyBytes;             // Mémoire propre de l'image clé
+        bool hasDelta;               // Même taille que le parent
+        std::vector<uint8_t> delta;  // XOR avec le parent, vide si déchargé
+
+        bool spilled;                // Données dans le fichier d'échange
+        uint64_t spillOffset;        // Delta puis références des tuiles de l'image clé
+        size_t spillDeltaSize;
+        size_t spillKeySize;
+    };
+
+    std::unordered_map<size_t, Node> nodes;
+    std::vector<size_t> roots;
+    size_t selected;
+    size_t nextId;
+    uint64_t useClock;
+
+    // Dernière grille ajoutée : évite de reconstruire le parent à chaque ajout
+    size_t cacheNode;
+    std::unique_ptr<Grid> cacheGrid;
+
+    int keyframeInterval;
+    size_t memoryBudget;
+    size_t nodesBytes;
+
+    TileStore tiles;
+
+    bool spillEnabled;
+    SpillFile spill;
+    std::unordered_map<TileStore::Hash, uint64_t, TileStore::Hasher> spilledTiles;
+    size_t spillLogicalBytes;
+
+    Grid materialize(size_t node) const;
+    const std::vector<uint8_t>& deltaOf(const Node& n, std::vector<uint8_t>& buffer) const;
+    Grid keyOf(const Node& n) const;
+    void spillNode(Node& n);
+    uint64_t spillTile(const Grid::Tile& tile);
+    static size_t countTiles(const Grid& grid);
+    size_t keyframeAncestor(size_t node) const;
+    size_t commonAncestor(size_t a, size_t b) const;
+    void makeKeyframe(Node& n, Grid& grid);
+    static size_t nodeBytes(const Node& n);
+    void removeNode(size_t id);
+    void evict();
+};
+
+}
@@ -0,0 +1,1569 @@
+#define CATCH_CONFIG_MAIN
+#include "catch_amalgamated.hpp"
+#include "components/Grid.h"
+#include "components/AliveCell.h"
+#include "components/DeadCell.h"
+#include "components/Quadtree.h"
+#include "interfaces/console.h"
+#include "services/BatchRun.h"
+#include "services/BinarySave.h"
+#include "services/BoardImage.h"
+#include "services/Game.h"
+#include "services/MacrocellFormat.h"
+#include "services/Recording.h"
+#include "services/RleFormat.h"
+#include "services/SaveIndex.h"
+#include "services/SaveQueue.h"
+#include "services/SpillFile.h"
+#include "services/SpscQueue.h"
+#include "services/TerminalRenderer.h"
+#include "services/TextSave.h"
+#include "services/ThumbnailCache.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <csignal>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+using namespace GameOfLife;
+
+namespace {
+
+// Soupe aléatoire reproductible, sur une grille dont les dimensions ne sont
+// pas des multiples de la taille des tuiles
+Grid randomGrid(int width, int height, unsigned seed) {
+    Grid grid(width, height);
+    std::mt19937 random(seed);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (random() % 3 == 0) {
+                grid.setCellCode(x, y, AliveCode);
+            }
+        }
+    }
+    return grid;
+}
+
+void writeText(const std::string& path, const std::string& text) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << text;
+}
+
+std::string readText(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Remplace size octets (little-endian) à la position offset du fichier
+void patchFile(const std::string& path, size_t offset, uint64_t value, size_t size) {
+    std::string data = readText(path);
+    for (size_t i = 0; i < size; ++i) {
+        data[offset + i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+    writeText(path, data);
+}
+
+// Mêmes dimensions et même état (obstacles compris) pour chaque cellule
+bool sameCells(const Grid& a, const Grid& b) {
+    if (a.getWidth() != b.getWidth() || a.getHeight() != b.getHeight()) {
+        return false;
+    }
+    for (int y = 0; y < a.getHeight(); ++y) {
+        for (int x = 0; x < a.getWidth(); ++x) {
+            if (a.getCellCode(x, y) != b.getCellCode(x, y)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Redirige std::cerr le temps d'une portée pour vérifier les messages d'erreur
+class CerrCapture {
+public:
+    CerrCapture() : previous(std::cerr.rdbuf(buffer.rdbuf())) {}
+    ~CerrCapture() { std::cerr.rdbuf(previous); }
+    std::string text() const { return buffer.str(); }
+
+private:
+    std::ostringstream buffer;
+    std::streambuf* previous;
+};
+
+// Répertoire de sauvegardes vide pour un test
+std::string emptyDirectory(const std::string& name) {
+    std::filesystem::remove_all(name);
+    std::filesystem::create_directories(name);
+    return name + "/";
+}
+
+// Date de modification avancée : le changement est visible même si le système
+// de fichiers ne distingue pas deux écritures rapprochées
+void touchLater(const std::string& path) {
+    std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(2));
+}
+
+const SaveIndex::Entry* findEntry(const SaveIndex& index, const std::string& name) {
+    for (const SaveIndex::Entry& entry : index.getEntries()) {
+        if (entry.name == name) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+// Attend que le fil de la cache produise la miniature (au plus 5 secondes)
+std::shared_ptr<const ThumbnailCache::Image> waitForThumbnail(ThumbnailCache& cache, const SaveIndex::Entry& entry) {
+    for (int i = 0; i < 500; ++i) {
+        if (auto image = cache.find(entry)) {
+            return image;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return nullptr;
+}
+
+std::string thumbnailPath(const std::string& directory, uint64_t hash) {
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hash));
+    return directory + ".thumbs/" + name + ".pgm";
+}
+
+// Transparence du pixel d'une cellule : 255 si vivante ou obstacle, 0 si morte
+int pixelAlpha(const BoardImage& image, int x, int y) {
+    return image.getPixels()[4 * (static_cast<size_t>(y) * image.getWidth() + x) + 3];
+}
+
+// Générations 0 à count de start, calculées sans historique
+std::vector<Grid> simulate(Grid grid, int count) {
+    std::vector<Grid> states{grid};
+    for (int i = 0; i < count; ++i) {
+        grid.update();
+        states.push_back(grid);
+    }
+    return states;
+}
+
+// Enregistre frames générations successives de grid (un obstacle apparaît en
+// cours de route) et retourne les images attendues
+std::vector<Grid> recordGame(const std::string& path, Grid grid, int frames) {
+    std::vector<Grid> expected{grid};
+    Recorder recorder;
+    REQUIRE(recorder.start(path, grid, 0));
+    for (int i = 1; i < frames; ++i) {
+        grid.update();
+        if (i == frames / 2) {
+            grid.setCellCode(1, 1, ObstacleAliveCode);
+        }
+        recorder.record(grid, i);
+        expected.push_back(grid);
+    }
+    REQUIRE(recorder.stop());
+    return expected;
+}
+
+// Relit tout l'enregistrement dans l'ordre ; faux à la première image manquante ou différente
+bool replaysAll(const std::string& path, const std::vector<Grid>& expected) {
+    RecordingPlayer player;
+    if (!player.open(path) || player.getFrameCount() != expected.size()) {
+        return false;
+    }
+    Grid frame(1, 1);
+    uint64_t generation = 0;
+    for (size_t i = 0; i < expected.size(); ++i) {
+        if (!player.next(frame, generation) || generation != i || !sameCells(frame, expected[i])) {
+            return false;
+        }
+    }
+    return !player.next(frame, generation);
+}
+
+}
+
+TEST_CASE("Grid Initialization", "[Grid]") {
+    Grid grid(10, 10);
+    REQUIRE(grid.getWidth() == 10);
+    REQUIRE(grid.getHeight() == 10);
+}
+
+TEST_CASE("Grid dimensions are capped", "[Grid]") {
+    // Près de INT_MAX, le nombre de tuiles déborderait
+    Grid wide(INT_MAX, 0);
+    REQUIRE(wide.getWidth() == Grid::MaxDimension);
+    REQUIRE(wide.getTileCount() == 0);
+}
+
+TEST_CASE("Cell Toggle", "[Grid]") {
+    Grid grid(5, 5);
+    REQUIRE(dynamic_cast<DeadCell*>(grid.getCell(2, 2)) != nullptr);
+    grid.toggleCellState(2, 2);
+    REQUIRE(dynamic_cast<AliveCell*>(grid.getCell(2, 2)) != nullptr);
+    grid.toggleCellState(2, 2);
+    REQUIRE(dynamic_cast<DeadCell*>(grid.getCell(2, 2)) != nullptr);
+}
+
+TEST_CASE("Births and deaths counted during the update", "[Grid]") {
+    // Comptage fait pendant le calcul, comparé à une comparaison des deux grilles
+    Grid grid = randomGrid(200, 150, 11);
+    grid.setCellCode(5, 5, ObstacleAliveCode);
+    for (int generation = 0; generation < 30; ++generation) {
+        Grid before(grid);
+        int created = 0;
+        int destroyed = 0;
+        grid.update(created, destroyed);
+        int expectedCreated = 0;
+        int expectedDestroyed = 0;
+        grid.countChanges(before, expectedCreated, expectedDestroyed);
+        REQUIRE(created == expectedCreated);
+        REQUIRE(destroyed == expectedDestroyed);
+        REQUIRE(grid.countAlive() == before.countAlive() + created - destroyed);
+    }
+}
+
+TEST_CASE("RLE round trip", "[RLE]") {
+    const std::string path = "test_roundtrip.rle";
+    Grid grid = randomGrid(150, 90, 1);
+    grid.setRule(1 << 3 | 1 << 6, 1 << 2 | 1 << 3);
+    grid.setToroidal(true);
+    REQUIRE(RleFormat::write(path, grid));
+
+    Grid loaded(1, 1);
+    REQUIRE(RleFormat::read(path, loaded));
+    REQUIRE(loaded.getWidth() == 150);
+    REQUIRE(loaded.getHeight() == 90);
+    REQUIRE(loaded.getRuleString() == "B36/S23");
+    REQUIRE(loaded.isToroidal());
+    REQUIRE(loaded == grid);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("RLE pattern centred in a larger grid", "[RLE]") {
+    const std::string path = "test_glider.rle";
+    writeText(path, "#N Planeur\r\n#C commentaire\r\nx = 3, y = 3, rule = B3/S23\r\nbo$2bo\r\n$3o!\r\n");
+
+    Grid loaded(1, 1);
+    REQUIRE(RleFormat::read(path, loaded, 11, 11));
+    REQUIRE(loaded.getWidth() == 11);
+    REQUIRE(loaded.countAlive() == 5);
+    REQUIRE(loaded.getCellCode(5, 4) == AliveCode);
+    REQUIRE(loaded.getCellCode(6, 5) == AliveCode);
+    REQUIRE(loaded.getCellCode(4, 6) == AliveCode);
+    REQUIRE(loaded.getCellCode(6, 6) == AliveCode);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("RLE multistate cells are alive", "[RLE]") {
+    const std::string path = "test_multistate.rle";
+    writeText(path, "x = 6, y = 1\n2o2pA.xX!\n");
+
+    Grid loaded(1, 1);
+    REQUIRE(RleFormat::read(path, loaded));
+    for (int x = 0; x < 6; ++x) {
+        REQUIRE(loaded.getCellCode(x, 0) == (x == 4 ? DeadCode : AliveCode));
+    }
+    std::remove(path.c_str());
+}
+
+TEST_CASE("RLE malformed input is rejected", "[RLE]") {
+    const std::string path = "test_malformed.rle";
+    const char* inputs[] = {
+        "bo$2bo$3o!\n",                  // En-tête manquant
+        "x = 3\nbo$2bo$3o!\n",           // Hauteur manquante
+        "x = -3, y = 3\nbo!\n",           // Dimension négative
+        "x = 0, y = 0\n!\n",               // Grille vide
+        "x = 3, y = 0\n!\n",               // Hauteur nulle
+        "x = 2147483647, y = 3\nbo!\n",   // Largeur au-delà de Grid::MaxDimension
+        "x = 3, y = 3, rule = Q\nbo!\n",  // Règle inconnue
+        "x = 3, y = 3\n3 o!\n",           // Répétition séparée de sa balise
+        "x = 3, y = 3\n2\no!\n",          // Répétition coupée par une fin de ligne
+        "x = 3, y = 3\npo!\n",            // État étendu incomplet
+        "x = 3, y = 3\nbzo!\n",           // Balise inconnue
+        "x = 3, y = 3\nbo$2",             // Fin de fichier au milieu d'une balise
+    };
+    for (const char* input : inputs) {
+        writeText(path, input);
+        Grid loaded(4, 4);
+        loaded.setCellCode(1, 1, AliveCode);
+        INFO(input);
+        REQUIRE_FALSE(RleFormat::read(path, loaded));
+        // La grille n'est pas modifiée par une lecture refusée
+        REQUIRE(loaded.getWidth() == 4);
+        REQUIRE(loaded.getCellCode(1, 1) == AliveCode);
+    }
+    std::remove(path.c_str());
+
+    Grid absent(1, 1);
+    REQUIRE_FALSE(RleFormat::read("test_absent.rle", absent));
+}
+
+TEST_CASE("Text save round trip over several chunks", "[TextSave]") {
+    const std::string path = "test_roundtrip.txt";
+    // Plus de 4 Mio de texte : quatre blocs analysés en parallèle, même sur une machine à un cœur
+    Grid::setThreadCount(4);
+    Grid original = randomGrid(2000, 1100, 11);
+    REQUIRE(TextSave::write(path, original));
+    REQUIRE(readText(path).size() > 4u << 20);
+
+    Grid loaded(1, 1);
+    REQUIRE(TextSave::read(path, loaded));
+    REQUIRE(sameCells(loaded, original));
+
+    // Une rangée fautive du dernier bloc est signalée avec son numéro de ligne dans le fichier
+    const size_t header = std::to_string(1100).size() + 1 + std::to_string(2000).size() + 1;
+    const size_t rowSize = 2 * 2000 + 1;
+    std::string text = readText(path);
+    text[header + 1000 * rowSize + 2 * 1500] = 'x';
+    writeText(path, text);
+    {
+        CerrCapture capture;
+        REQUIRE_FALSE(TextSave::read(path, loaded));
+        REQUIRE(capture.text().find("ligne 1002") != std::string::npos);
+        REQUIRE(capture.text().find("valeur \"x\" en colonne 1501") != std::string::npos);
+    }
+    REQUIRE(sameCells(loaded, original));
+    Grid::setThreadCount(0);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Text save with irregular spacing", "[TextSave]") {
+    const std::string path = "test_spacing.txt";
+    // Largeur non multiple de 8 et de 16 : fin de rangée lue cellule par cellule
+    Grid original = randomGrid(37, 5, 12);
+    REQUIRE(TextSave::write(path, original));
+    Grid loaded(1, 1);
+    REQUIRE(TextSave::read(path, loaded));
+    REQUIRE(sameCells(loaded, original));
+
+    writeText(path, "2 3\n1  0\t1 \r\n 0 1 1\n\n");
+    REQUIRE(TextSave::read(path, loaded));
+    REQUIRE(loaded.getWidth() == 3);
+    REQUIRE(loaded.getHeight() == 2);
+    REQUIRE(loaded.getCellCode(0, 0) == AliveCode);
+    REQUIRE(loaded.getCellCode(1, 0) != AliveCode);
+    REQUIRE(loaded.getCellCode(2, 0) == AliveCode);
+    REQUIRE(loaded.getCellCode(0, 1) != AliveCode);
+    REQUIRE(loaded.getCellCode(2, 1) == AliveCode);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Text save malformed rows are rejected", "[TextSave]") {
+    const std::string path = "test_malformed.txt";
+    const std::string row = "0 1 0 1 0 1 0 1 0 1 0 1 0 1 0 1 0 1 0 1\n";  // 20 valeurs
+    struct Case {
+        std::string text;
+        std::string message;
+    };
+    const Case cases[] = {
+        {"3 20\n" + row + "0 1 0 1 0 1 0 1 0 1 0 1 0 1 0 1 0 2 0 1\n" + row,
+         "ligne 3) : valeur \"2\" en colonne 18 (0 ou 1 attendu)"},
+        {"3 20\n" + row + row + "0 1 0 1 0 1 0 1 0 1 0 1 0 1 0 1 0 1 0\n", "ligne 4) : 19 valeurs au lieu de 20"},
+        {"3 20\n" + row + "0 1 0 1 0 1 0 1 0 1 0 1 0 1 0 1 0 1 0 1 1\n" + row, "ligne 3) : plus de 20 valeurs"},
+        {"3 20\n10 1 0 1 0 1 0 1 0 1 0 1 0 1 0 1 0 1 0 1\n" + row + row,
+         "ligne 2) : valeur \"10\" en colonne 1 (0 ou 1 attendu)"},
+        {"3 20\n" + row + row + row + row, "ligne 5) : plus de 3 rangées"},
+        {"3 20\n" + row + row, "ligne 4) : 3 rangées attendues, 2 trouvées"},
+        {"3\n" + row, "ligne 1) : en-tête \"hauteur largeur\" invalide"},
+        {"0 20\n", "ligne 1) : en-tête \"hauteur largeur\" invalide"},
+    };
+    for (const Case& test : cases) {
+        writeText(path, test.text);
+        Grid loaded(4, 4);
+        loaded.setCellCode(1, 1, AliveCode);
+        INFO(test.message);
+        CerrCapture capture;
+        REQUIRE_FALSE(TextSave::read(path, loaded));
+        REQUIRE(capture.text().find(test.message) != std::string::npos);
+        REQUIRE(loaded.getWidth() == 4);
+        REQUIRE(loaded.getCellCode(1, 1) == AliveCode);
+    }
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Binary save round trip", "[BinarySave]") {
+    const std::string path = "test_roundtrip.golb";
+    Grid grid = randomGrid(200, 130, 2);
+    grid.setCellCode(3, 4, ObstacleDeadCode);
+    grid.setCellCode(70, 80, ObstacleAliveCode);
+    grid.setCellCode(199, 129, DeadObstacleCode);
+    grid.setRule(1 << 3, 1 << 2 | 1 << 3 | 1 << 4);
+    grid.setToroidal(true);
+    REQUIRE(BinarySave::write(path, grid, 1234));
+
+    Grid loaded(1, 1);
+    uint64_t generation = 0;
+    REQUIRE(BinarySave::read(path, loaded, generation));
+    REQUIRE(generation == 1234);
+    REQUIRE(loaded.getRuleString() == grid.getRuleString());
+    REQUIRE(loaded.isToroidal());
+    REQUIRE(sameCells(loaded, grid));
+
+    // Les tuiles projetées restent modifiables sans toucher au fichier
+    loaded.setCellCode(0, 0, loaded.getCellCode(0, 0) == AliveCode ? DeadCode : AliveCode);
+    loaded.update();
+    Grid reloaded(1, 1);
+    REQUIRE(BinarySave::read(path, reloaded, generation));
+    REQUIRE(sameCells(reloaded, grid));
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Binary save of an empty grid", "[BinarySave]") {
+    const std::string path = "test_empty.golb";
+    REQUIRE(BinarySave::write(path, Grid(65, 1), 0));
+    Grid loaded(1, 1);
+    uint64_t generation = 1;
+    REQUIRE(BinarySave::read(path, loaded, generation));
+    REQUIRE(loaded.getWidth() == 65);
+    REQUIRE(loaded.countAlive() == 0);
+    REQUIRE(generation == 0);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Binary save stores identical tiles once", "[BinarySave]") {
+    const std::string path = "test_shared.golb";
+    // Même bloc dans quatre tuiles, copié cellule par cellule (tuiles distinctes en mémoire)
+    Grid grid(4 * Grid::TileSize, Grid::TileSize);
+    for (int tile = 0; tile < 4; ++tile) {
+        grid.setCellCode(tile * Grid::TileSize + 10, 10, AliveCode);
+        grid.setCellCode(tile * Grid::TileSize + 11, 10, AliveCode);
+        grid.setCellCode(tile * Grid::TileSize + 10, 11, AliveCode);
+        grid.setCellCode(tile * Grid::TileSize + 11, 11, AliveCode);
+    }
+    grid.setCellCode(3 * Grid::TileSize + 40, 40, AliveCode);
+    REQUIRE(BinarySave::write(path, grid, 0));
+
+    const std::string data = readText(path);
+    uint32_t storedTiles = 0;
+    for (int i = 0; i < 4; ++i) {
+        storedTiles |= static_cast<uint32_t>(static_cast<uint8_t>(data[36 + i])) << (8 * i);
+    }
+    REQUIRE(storedTiles == 2);
+    Grid loaded(1, 1);
+    uint64_t generation = 0;
+    REQUIRE(BinarySave::read(path, loaded, generation));
+    REQUIRE(sameCells(loaded, grid));
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Binary save corrupt files are rejected", "[BinarySave]") {
+    const std::string valid = "test_valid.golb";
+    const std::string path = "test_corrupt.golb";
+    REQUIRE(BinarySave::write(valid, randomGrid(100, 70, 3), 5));
+    const std::string data = readText(valid);
+
+    struct Corruption {
+        const char* description;
+        size_t offset;
+        uint64_t value;
+        size_t size;
+    };
+    const Corruption corruptions[] = {
+        {"signature", 0, 0x424C4F48, 4},
+        {"version", 4, 99, 2},
+        {"taille de l'en-tête", 6, 8, 2},
+        {"taille de tuile", 32, 32, 4},
+        {"largeur", 8, 0xFFFFFFFF, 4},
+        {"largeur nulle", 8, 0, 4},
+        {"hauteur nulle", 12, 0, 4},
+        {"largeur proche de INT_MAX", 8, 0x7FFFFFFF, 4},
+        {"table hors du fichier", 40, 0xFFFFFFFFFFFFFFFCULL, 8},
+        {"table mal alignée", 40, 66, 8},
+        {"tuiles hors du fichier", 48, 0xFFFFFFFFFFFFFFC0ULL, 8},
+        {"nombre de tuiles", 36, 0xFFFFFFFF, 4},
+        {"numéro de tuile", 64, 1000, 4},
+    };
+    for (const Corruption& corruption : corruptions) {
+        writeText(path, data);
+        patchFile(path, corruption.offset, corruption.value, corruption.size);
+        Grid loaded(4, 4);
+        uint64_t generation = 0;
+        INFO(corruption.description);
+        REQUIRE_FALSE(BinarySave::read(path, loaded, generation));
+        REQUIRE(loaded.getWidth() == 4);
+    }
+
+    // Fichiers tronqués : en-tête incomplet, tuiles manquantes
+    for (size_t size : {size_t(10), data.size() / 2}) {
+        writeText(path, data.substr(0, size));
+        Grid loaded(4, 4);
+        uint64_t generation = 0;
+        REQUIRE_FALSE(BinarySave::read(path, loaded, generation));
+    }
+
+    // Cellules au-delà de la largeur dans une tuile du bord
+    Grid full(64, 10);
+    full.setCellCode(40, 2, AliveCode);
+    REQUIRE(BinarySave::write(path, full, 0));
+    patchFile(path, 8, 10, 4);
+    Grid loaded(4, 4);
+    uint64_t generation = 0;
+    REQUIRE_FALSE(BinarySave::read(path, loaded, generation));
+
+    std::remove(valid.c_str());
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Macrocell round trip", "[Macrocell]") {
+    const std::string path = "test_roundtrip.mc";
+    Grid grid = randomGrid(300, 200, 4);
+    Quadtree tree;
+    tree.build(grid);
+    REQUIRE(MacrocellFormat::write(path, tree, "B36/S23", 77));
+
+    Quadtree loaded;
+    uint16_t birth = 0, survival = 0;
+    uint64_t generation = 0;
+    REQUIRE(MacrocellFormat::read(path, loaded, birth, survival, generation));
+    REQUIRE(generation == 77);
+    REQUIRE(birth == (1 << 3 | 1 << 6));
+    REQUIRE(survival == (1 << 2 | 1 << 3));
+    REQUIRE(loaded.populationOf(loaded.getRoot()) == static_cast<uint64_t>(grid.countAlive()));
+
+    Grid flattened(300, 200);
+    loaded.flatten(flattened, 0, 0);
+    REQUIRE(flattened == grid);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Macrocell window of a huge sparse pattern", "[Macrocell]") {
+    // Planeur dans le coin inférieur droit d'un motif de 2^41 cellules de côté
+    const std::string path = "test_huge.mc";
+    std::string text = "[M2] (golly 4.2)\n#R B3/S23\n#G 12\n.*$..*$***$\n";
+    for (int level = 4; level <= 41; ++level) {
+        text += std::to_string(level) + " 0 0 0 " + std::to_string(level - 3) + "\n";
+    }
+    writeText(path, text);
+
+    Quadtree loaded;
+    uint16_t birth = 0, survival = 0;
+    uint64_t generation = 0;
+    REQUIRE(MacrocellFormat::read(path, loaded, birth, survival, generation));
+    REQUIRE(generation == 12);
+    REQUIRE(loaded.getRootLevel() == 41);
+    REQUIRE(loaded.populationOf(loaded.getRoot()) == 5);
+
+    // Seule la fenêtre demandée est dépliée
+    const int64_t corner = (int64_t(1) << 41) - 8;
+    Grid window(10, 10);
+    loaded.flatten(window, corner - 1, corner - 1);
+    REQUIRE(window.countAlive() == 5);
+    REQUIRE(window.getCellCode(2, 1) == AliveCode);
+    REQUIRE(window.getCellCode(3, 2) == AliveCode);
+    REQUIRE(window.getCellCode(1, 3) == AliveCode);
+
+    Grid empty(10, 10);
+    loaded.flatten(empty, 0, 0);
+    REQUIRE(empty.countAlive() == 0);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Macrocell malformed input is rejected", "[Macrocell]") {
+    const std::string path = "test_malformed.mc";
+    const char* inputs[] = {
+        "#R B3/S23\n.*$\n4 1 0 0 0\n",        // En-tête manquant
+        "[M2]\n#R Q\n.*$\n4 1 0 0 0\n",        // Règle inconnue
+        "[M2]\n.........*$\n",                 // Feuille trop large
+        "[M2]\n.*$.$.$.$.$.$.$.$.*$\n",        // Feuille trop haute
+        "[M2]\n.*x$\n",                        // Caractère inconnu dans une feuille
+        "[M2]\n.*$\n4 1 0 0\n",               // Nœud incomplet
+        "[M2]\n.*$\n4 1 0 0 zéro\n",          // Nœud illisible
+        "[M2]\n.*$\n3 1 0 0 0\n",             // Niveau réservé aux feuilles
+        "[M2]\n.*$\n2 1 0 0 0\n",             // Niveau 2 : règles à plusieurs états
+        "[M2]\n.*$\n4 2 0 0 0\n",             // Référence vers une ligne suivante
+        "[M2]\n.*$\n4 1 0 0 0\n6 2 0 0 0\n", // Enfant du mauvais niveau
+        "[M2]\n#C vide\n",                     // Aucun nœud
+    };
+    Quadtree tree;
+    tree.build(randomGrid(20, 20, 5));
+    uint32_t root = tree.getRoot();
+    for (const char* input : inputs) {
+        writeText(path, input);
+        uint16_t birth = 0, survival = 0;
+        uint64_t generation = 0;
+        INFO(input);
+        REQUIRE_FALSE(MacrocellFormat::read(path, tree, birth, survival, generation));
+        // L'arbre n'est pas modifié par une lecture refusée
+        REQUIRE(tree.getRoot() == root);
+    }
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Macrocell pattern window in a game", "[Macrocell]") {
+    const std::string pattern = "test_game.mc";
+    const std::string other = "test_game.rle";
+    Grid grid = randomGrid(300, 300, 6);
+    Quadtree tree;
+    tree.build(grid);
+    REQUIRE(MacrocellFormat::write(pattern, tree, "B3/S23", 40));
+    REQUIRE(RleFormat::write(other, randomGrid(20, 20, 7)));
+
+    Game game(64, 64, 100);
+    REQUIRE(game.loadFromPath(pattern));
+    REQUIRE(game.hasPattern());
+    REQUIRE(game.getIterations() == 40);
+
+    // Déplacer la fenêtre déplie la zone correspondante, à la génération du motif
+    game.step();
+    game.setPatternViewport(100, 50);
+    REQUIRE(game.getIterations() == 40);
+    Grid expected(64, 64);
+    for (int y = 0; y < 64; ++y) {
+        for (int x = 0; x < 64; ++x) {
+            expected.setCellCode(x, y, grid.getCellCode(100 + x, 50 + y));
+        }
+    }
+    REQUIRE(sameCells(game.getGrid(), expected));
+
+    // Un autre format libère le motif
+    REQUIRE(game.loadFromPath(other));
+    REQUIRE_FALSE(game.hasPattern());
+    std::remove(pattern.c_str());
+    std::remove(other.c_str());
+}
+
+TEST_CASE("Recording round trip", "[Recording]") {
+    const std::string path = "test_roundtrip.golr";
+    Grid grid = randomGrid(150, 100, 8);
+    grid.setCellCode(2, 3, DeadObstacleCode);
+    grid.setRule(1 << 3 | 1 << 6, 1 << 2 | 1 << 3);
+    grid.setToroidal(true);
+    // Trois blocs, le dernier incomplet
+    std::vector<Grid> expected = recordGame(path, grid, 2 * static_cast<int>(Recording::FramesPerChunk) + 10);
+    REQUIRE(replaysAll(path, expected));
+
+    // Accès direct, en avant comme en arrière et d'un bloc à l'autre
+    RecordingPlayer player;
+    REQUIRE(player.open(path));
+    Grid frame(1, 1);
+    uint64_t generation = 0;
+    for (uint64_t target : {100, 3, 137, 64, 63, 0, 137}) {
+        REQUIRE(player.seek(target, frame, generation));
+        REQUIRE(generation == target);
+        REQUIRE(sameCells(frame, expected[target]));
+    }
+    REQUIRE(frame.getRuleString() == grid.getRuleString());
+    REQUIRE(frame.isToroidal());
+    REQUIRE_FALSE(player.seek(expected.size(), frame, generation));
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Recording without its index", "[Recording]") {
+    const std::string valid = "test_valid.golr";
+    const std::string path = "test_truncated.golr";
+    std::vector<Grid> expected = recordGame(valid, randomGrid(100, 70, 9), 150);
+    const std::string data = readText(valid);
+    uint64_t indexOffset = 0;
+    for (int i = 0; i < 8; ++i) {
+        indexOffset |= static_cast<uint64_t>(static_cast<uint8_t>(data[data.size() - 12 + i])) << (8 * i);
+    }
+
+    // Enregistrement interrompu avant l'index : les blocs sont parcourus
+    writeText(path, data.substr(0, indexOffset));
+    REQUIRE(replaysAll(path, expected));
+
+    // Dernier bloc tronqué : seuls les blocs complets restent lisibles
+    writeText(path, data.substr(0, indexOffset - 10));
+    expected.erase(expected.begin() + 2 * Recording::FramesPerChunk, expected.end());
+    REQUIRE(replaysAll(path, expected));
+
+    // En-tête seul
+    writeText(path, data.substr(0, 40));
+    RecordingPlayer player;
+    REQUIRE_FALSE(player.open(path));
+    std::remove(valid.c_str());
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Recording corrupt files are rejected", "[Recording]") {
+    const std::string valid = "test_valid.golr";
+    const std::string path = "test_corrupt.golr";
+    std::vector<Grid> expected = recordGame(valid, randomGrid(100, 70, 10), 150);
+    const std::string data = readText(valid);
+    const size_t header = 32;
+    uint64_t indexOffset = 0;
+    for (int i = 0; i < 8; ++i) {
+        indexOffset |= static_cast<uint64_t>(static_cast<uint8_t>(data[data.size() - 12 + i])) << (8 * i);
+    }
+    const size_t entries = indexOffset + 8;
+
+    struct Corruption {
+        const char* description;
+        size_t offset;
+        uint64_t value;
+        size_t size;
+    };
+
+    // Index incohérent : ignoré, les blocs sont alors parcourus un à un
+    const Corruption indexCorruptions[] = {
+        {"première image non nulle", entries, 5, 8},
+        {"images décroissantes", entries + 16, 0, 8},
+        {"écart de plus d'un bloc", entries + 16, 1000, 8},
+        {"position avant l'en-tête", entries + 8, 0, 8},
+        {"position après l'index", entries + 24, indexOffset, 8},
+        {"nombre de blocs", indexOffset + 4, 0xFFFFFFFF, 4},
+    };
+    for (const Corruption& corruption : indexCorruptions) {
+        writeText(path, data);
+        patchFile(path, corruption.offset, corruption.value, corruption.size);
+        INFO(corruption.description);
+        REQUIRE(replaysAll(path, expected));
+    }
+
+    // Bloc incohérent : refusé avant toute allocation, sans image fausse
+    const Corruption chunkCorruptions[] = {
+        {"taille compressée", header + 12, 0xFFFFFFF0, 4},
+        {"taille décompressée", header + 8, 0xFFFFFFF0, 4},
+        {"nombre d'images", header + 4, 1000, 4},
+        {"première image", header + 16, 7, 8},
+    };
+    for (const Corruption& corruption : chunkCorruptions) {
+        writeText(path, data);
+        patchFile(path, corruption.offset, corruption.value, corruption.size);
+        INFO(corruption.description);
+        RecordingPlayer player;
+        REQUIRE(player.open(path));
+        Grid frame(1, 1);
+        uint64_t generation = 0;
+        REQUIRE_FALSE(player.next(frame, generation));
+    }
+
+    // Autre version du format
+    writeText(path, data);
+    patchFile(path, 4, 1, 2);
+    RecordingPlayer player;
+    REQUIRE_FALSE(player.open(path));
+    std::remove(valid.c_str());
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Save queue writes through a temporary file", "[SaveQueue]") {
+    const std::string path = "test_atomic.txt";
+    writeText(path, "ancien");
+    std::string temporary;
+
+    // Écriture refusée : l'ancien fichier reste intact, sans fichier temporaire
+    REQUIRE_FALSE(SaveQueue::writeAtomically(path, [&](const std::string& target) {
+        temporary = target;
+        writeText(target, "tronqué");
+        return false;
+    }));
+    REQUIRE(temporary != path);
+    REQUIRE_FALSE(std::ifstream(temporary).good());
+    REQUIRE(readText(path) == "ancien");
+
+    // Écriture réussie : le fichier temporaire est renommé
+    REQUIRE(SaveQueue::writeAtomically(path, [&](const std::string& target) {
+        temporary = target;
+        REQUIRE(readText(path) == "ancien");
+        writeText(target, "nouveau");
+        return true;
+    }));
+    REQUIRE_FALSE(std::ifstream(temporary).good());
+    REQUIRE(readText(path) == "nouveau");
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Save queue bounded by blocking", "[SaveQueue]") {
+    SaveQueue queue;
+    queue.setLimit(1, SaveQueue::Block);
+    std::promise<void> release;
+    std::shared_future<void> gate = release.get_future().share();
+    std::atomic<int> started(0);
+    auto writer = [&](const std::string& target) {
+        ++started;
+        gate.wait();
+        writeText(target, "x");
+        return true;
+    };
+
+    queue.submit("test_block_0.txt", writer);
+    while (started == 0) {
+        std::this_thread::yield();
+    }
+    queue.submit("test_block_1.txt", writer);  // En attente : la file est pleine
+
+    std::atomic<bool> submitted(false);
+    std::thread submitter([&] {
+        queue.submit("test_block_2.txt", writer);
+        submitted = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    REQUIRE_FALSE(submitted);
+
+    // Une limite levée pendant l'attente libère l'appelant
+    queue.setLimit(0, SaveQueue::Block);
+    submitter.join();
+    REQUIRE(submitted);
+
+    release.set_value();
+    queue.wait();
+    REQUIRE(queue.getDropped() == 0);
+    for (int i = 0; i < 3; ++i) {
+        std::string path = "test_block_" + std::to_string(i) + ".txt";
+        REQUIRE(readText(path) == "x");
+        std::remove(path.c_str());
+    }
+}
+
+TEST_CASE("Save queue bounded by dropping the oldest", "[SaveQueue]") {
+    SaveQueue queue;
+    queue.setLimit(1, SaveQueue::DropOldest);
+    std::promise<void> release;
+    std::shared_future<void> gate = release.get_future().share();
+    std::atomic<int> started(0);
+    auto writer = [&](const std::string& target) {
+        ++started;
+        gate.wait();
+        writeText(target, "x");
+        return true;
+    };
+
+    queue.submit("test_drop_0.txt", writer);
+    while (started == 0) {
+        std::this_thread::yield();
+    }
+    queue.submit("test_drop_1.txt", writer);
+    queue.submit("test_drop_2.txt", writer);  // Remplace test_drop_1, jamais écrit
+    REQUIRE(queue.getDropped() == 1);
+
+    release.set_value();
+    queue.wait();
+    std::vector<std::string> written;
+    SaveQueue::Result result;
+    while (queue.poll(result)) {
+        REQUIRE(result.success);
+        written.push_back(result.path);
+    }
+    REQUIRE(written == std::vector<std::string>{"test_drop_0.txt", "test_drop_2.txt"});
+    REQUIRE_FALSE(std::ifstream("test_drop_1.txt").good());
+    std::remove("test_drop_0.txt");
+    std::remove("test_drop_2.txt");
+}
+
+TEST_CASE("Snapshots named past 32-bit generations", "[SaveQueue]") {
+    Game game(16, 16, 0);
+    game.getGrid().setCellCode(1, 1, AliveCode);
+    game.startSnapshots("test_snapshot", ".golb", 1, 4, SaveQueue::Block);
+    game.setIterations(4999999999ULL);
+    game.step();
+    REQUIRE(game.stopSnapshots());
+    REQUIRE(game.getIterations() == 5000000000ULL);
+
+    const std::string path = "test_snapshot_5000000000.golb";
+    Grid loaded(1, 1);
+    uint64_t generation = 0;
+    REQUIRE(BinarySave::read(path, loaded, generation));
+    REQUIRE(generation == 5000000000ULL);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Board image full redraw covers the whole board", "[BoardImage]") {
+    Grid grid = randomGrid(200, 150, 41);
+    grid.setCellCode(3, 4, ObstacleAliveCode);
+    BoardImage image;
+    auto requireFull = [&](const std::vector<BoardImage::Region>& regions) {
+        REQUIRE(regions.size() == 1);
+        REQUIRE(regions[0].x == 0);
+        REQUIRE(regions[0].y == 0);
+        REQUIRE(regions[0].width == grid.getWidth());
+        REQUIRE(regions[0].height == grid.getHeight());
+    };
+    requireFull(image.render(grid));
+    REQUIRE(image.getWidth() == 200);
+    REQUIRE(image.getHeight() == 150);
+    bool matches = true;
+    for (int y = 0; y < grid.getHeight(); ++y) {
+        for (int x = 0; x < grid.getWidth(); ++x) {
+            matches = matches && pixelAlpha(image, x, y) == (grid.getCellCode(x, y) == DeadCode ? 0 : 255);
+        }
+    }
+    REQUIRE(matches);
+    const uint8_t* obstacle = image.getPixels() + 4 * (4 * 200 + 3);
+    REQUIRE(obstacle[0] == 128);
+
+    // Après invalidate(), après un changement de taille ou quand plus de la moitié des tuiles change
+    image.invalidate();
+    requireFull(image.render(grid));
+    grid = randomGrid(130, 70, 42);
+    requireFull(image.render(grid));
+    grid.update();
+    requireFull(image.render(grid));
+}
+
+TEST_CASE("Board image redraws only the toggled cell's tile", "[BoardImage]") {
+    Grid grid = randomGrid(200, 150, 43);
+    BoardImage image;
+    image.render(grid);
+    REQUIRE(image.render(grid).empty());
+
+    // Une cellule changée : seule sa tuile est recalculée et renvoyée
+    const bool wasAlive = grid.getCellCode(130, 70) == AliveCode;
+    grid.setCellCode(130, 70, wasAlive ? DeadCode : AliveCode);
+    const std::vector<BoardImage::Region> regions = image.render(grid);
+    REQUIRE(regions.size() == 1);
+    REQUIRE(regions[0].x == 128);
+    REQUIRE(regions[0].y == 64);
+    REQUIRE(regions[0].width == 64);
+    REQUIRE(regions[0].height == 64);
+    REQUIRE(pixelAlpha(image, 130, 70) == (wasAlive ? 0 : 255));
+
+    // Pixels de la zone contigus, ligne par ligne
+    const uint8_t* region = image.getRegionPixels(regions[0]);
+    REQUIRE(region[4 * (6 * 64 + 2) + 3] == (wasAlive ? 0 : 255));
+    REQUIRE(std::equal(region + 4 * 64 * 10, region + 4 * 64 * 11, image.getPixels() + 4 * (74 * 200 + 128)));
+
+    // Tuile du coin, tronquée par le bord du plateau ; voisines d'une rangée réunies
+    grid.setCellCode(199, 149, AliveCode);
+    grid.setCellCode(5, 1, ObstacleAliveCode);
+    grid.setCellCode(70, 1, ObstacleAliveCode);
+    const std::vector<BoardImage::Region> corner = image.render(grid);
+    REQUIRE(corner.size() == 2);
+    REQUIRE(corner[0].x == 0);
+    REQUIRE(corner[0].y == 0);
+    REQUIRE(corner[0].width == 128);
+    REQUIRE(corner[0].height == 64);
+    REQUIRE(corner[1].x == 192);
+    REQUIRE(corner[1].y == 128);
+    REQUIRE(corner[1].width == 8);
+    REQUIRE(corner[1].height == 22);
+    REQUIRE(pixelAlpha(image, 199, 149) == 255);
+    REQUIRE(image.render(grid).empty());
+}
+
+TEST_CASE("Save index rebuilt and updated after a save", "[SaveIndex]") {
+    const std::string directory = emptyDirectory("test_index");
+    Grid glider(40, 30);
+    const int cells[][2] = {{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}};
+    for (const auto& cell : cells) {
+        glider.setCellCode(cell[0], cell[1], AliveCode);
+    }
+    REQUIRE(BinarySave::write(directory + "a.golb", glider, 7));
+    Grid soup = randomGrid(20, 10, 21);
+    REQUIRE(TextSave::write(directory + "b.txt", soup));
+    writeText(directory + "notes.md", "pas une sauvegarde");
+
+    SaveIndex index(directory);
+    index.refresh();
+    REQUIRE(index.getEntries().size() == 2);
+    const SaveIndex::Entry& first = index.getEntries()[0];
+    REQUIRE(first.name == "a.golb");
+    REQUIRE(first.readable);
+    REQUIRE(first.width == 40);
+    REQUIRE(first.height == 30);
+    REQUIRE(first.population == 5);
+    REQUIRE(first.generation == 7);
+    REQUIRE(first.rule == "B3/S23");
+    REQUIRE(first.hash == SaveIndex::hashFile(directory + "a.golb"));
+    REQUIRE(SaveIndex::describe(first) == "40 x 30, 5 cellules, B3/S23, génération 7");
+    REQUIRE(index.getEntries()[1].population == static_cast<uint64_t>(soup.countAlive()));
+
+    // Un fichier inchangé n'est pas relu : la valeur de l'index sur disque est reprise telle quelle
+    std::string text = readText(directory + SaveIndex::FileName);
+    size_t line = text.find("b.txt\t");
+    REQUIRE(line != std::string::npos);
+    size_t field = line;
+    for (int i = 0; i < 6; ++i) {
+        field = text.find('\t', field) + 1;
+    }
+    text.replace(field, text.find('\t', field) - field, "999");
+    writeText(directory + SaveIndex::FileName, text);
+    SaveIndex cached(directory);
+    cached.refresh();
+    REQUIRE(findEntry(cached, "b.txt")->population == 999);
+
+    // Même taille, date plus récente : le fichier est relu et l'index réécrit
+    Grid other = randomGrid(20, 10, 22);
+    REQUIRE(TextSave::write(directory + "b.txt", other));
+    touchLater(directory + "b.txt");
+    cached.refresh();
+    const SaveIndex::Entry* updated = findEntry(cached, "b.txt");
+    REQUIRE(updated->population == static_cast<uint64_t>(other.countAlive()));
+    REQUIRE(updated->hash == SaveIndex::hashFile(directory + "b.txt"));
+    REQUIRE(updated->hash != index.getEntries()[1].hash);
+    SaveIndex reloaded(directory);
+    reloaded.refresh();
+    REQUIRE(findEntry(reloaded, "b.txt")->population == static_cast<uint64_t>(other.countAlive()));
+
+    // Ajout et suppression suivis par l'index en mémoire comme par celui sur disque
+    REQUIRE(BinarySave::write(directory + "c.golb", soup, 0));
+    std::remove((directory + "a.golb").c_str());
+    cached.refresh();
+    REQUIRE(cached.getEntries().size() == 2);
+    REQUIRE(cached.getEntries()[0].name == "b.txt");
+    REQUIRE(cached.getEntries()[1].name == "c.golb");
+    REQUIRE(readText(directory + SaveIndex::FileName).find("a.golb") == std::string::npos);
+
+    // Index illisible : reconstruit entièrement
+    writeText(directory + SaveIndex::FileName, "GOLI 0\nn'importe quoi\n");
+    SaveIndex rebuilt(directory);
+    rebuilt.refresh();
+    REQUIRE(rebuilt.getEntries().size() == 2);
+    REQUIRE(findEntry(rebuilt, "c.golb")->population == static_cast<uint64_t>(soup.countAlive()));
+    REQUIRE(readText(directory + SaveIndex::FileName).rfind("GOLI 1\n", 0) == 0);
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Thumbnails reused while the save is unchanged", "[SaveIndex]") {
+    const std::string directory = emptyDirectory("test_thumbs");
+    Grid grid(64, 64);
+    for (int y = 0; y < 2; ++y) {
+        for (int x = 0; x < 2; ++x) {
+            grid.setCellCode(x, y, AliveCode);
+        }
+    }
+    REQUIRE(BinarySave::write(directory + "a.golb", grid, 0));
+    SaveIndex index(directory);
+    index.refresh();
+    const SaveIndex::Entry entry = index.getEntries().at(0);
+
+    std::shared_ptr<const ThumbnailCache::Image> image;
+    {
+        ThumbnailCache cache(directory);
+        image = waitForThumbnail(cache, entry);
+        REQUIRE(image);
+        REQUIRE(image->width == 64);
+        REQUIRE(image->pixels[0] == ThumbnailCache::Full);
+        REQUIRE(image->pixels[63 * 64 + 63] == 0);
+        REQUIRE(cache.find(entry) == image);
+    }
+    const std::string cached = thumbnailPath(directory, entry.hash);
+    REQUIRE(std::filesystem::exists(cached));
+
+    // Sauvegarde inchangée : une nouvelle cache relit l'image du disque (marquée ici) sans la recalculer
+    std::string pgm = readText(cached);
+    pgm.back() = 77;
+    writeText(cached, pgm);
+    ThumbnailCache cache(directory);
+    image = waitForThumbnail(cache, entry);
+    REQUIRE(image);
+    REQUIRE(image->pixels[63 * 64 + 63] == 77);
+
+    // Sauvegarde modifiée : nouvelle empreinte, nouvelle miniature calculée
+    grid.clearGrid();
+    grid.setCellCode(63, 63, AliveCode);
+    REQUIRE(BinarySave::write(directory + "a.golb", grid, 0));
+    touchLater(directory + "a.golb");
+    index.refresh();
+    const SaveIndex::Entry changed = index.getEntries().at(0);
+    REQUIRE(changed.hash != entry.hash);
+    image = waitForThumbnail(cache, changed);
+    REQUIRE(image);
+    REQUIRE(image->pixels[0] == 0);
+    REQUIRE(image->pixels[63 * 64 + 63] == ThumbnailCache::Full);
+    REQUIRE(std::filesystem::exists(thumbnailPath(directory, changed.hash)));
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Undo and redo restore the exact grid", "[Timeline]") {
+    const int steps = 40;
+    std::vector<Grid> expected = simulate(randomGrid(150, 100, 21), steps);
+    Game game(1, 1, 0);
+    game.getGrid() = expected[0];
+    for (int i = 0; i < steps; ++i) {
+        game.step();
+    }
+    REQUIRE(sameCells(game.getGrid(), expected[steps]));
+
+    for (int i = steps - 1; i >= 0; --i) {
+        game.undo();
+        INFO(i);
+        REQUIRE(game.getTimelinePosition() == static_cast<size_t>(i));
+        REQUIRE(sameCells(game.getGrid(), expected[i]));
+    }
+    // Rien avant l'état initial
+    game.undo();
+    REQUIRE(sameCells(game.getGrid(), expected[0]));
+
+    for (int i = 1; i <= steps; ++i) {
+        game.redo();
+        INFO(i);
+        REQUIRE(sameCells(game.getGrid(), expected[i]));
+    }
+    game.redo();
+    REQUIRE(sameCells(game.getGrid(), expected[steps]));
+}
+
+TEST_CASE("Seek to any generation matches a fresh simulation", "[Timeline]") {
+    // Plusieurs intervalles d'images clés, parcourus dans le désordre
+    const int steps = 100;
+    std::vector<Grid> expected = simulate(randomGrid(130, 90, 22), steps);
+    Game game(1, 1, 0);
+    game.getGrid() = expected[0];
+    for (int i = 0; i < steps; ++i) {
+        game.step();
+    }
+    REQUIRE(game.getTimelineEnd() == static_cast<size_t>(steps) + 1);
+
+    std::vector<size_t> order;
+    for (size_t generation = 0; generation <= static_cast<size_t>(steps); ++generation) {
+        order.push_back(generation);
+    }
+    std::shuffle(order.begin(), order.end(), std::mt19937(22));
+    for (size_t generation : order) {
+        game.seek(generation);
+        INFO(generation);
+        REQUIRE(game.getTimelinePosition() == generation);
+        REQUIRE(sameCells(game.getGrid(), expected[generation]));
+    }
+
+    // Hors de l'historique : la position est ramenée à ses bornes
+    game.seek(steps + 50);
+    REQUIRE(sameCells(game.getGrid(), expected[steps]));
+    game.seek(0);
+    REQUIRE(game.getIterations() == 0);
+    REQUIRE(sameCells(game.getGrid(), expected[0]));
+}
+
+TEST_CASE("Undo and redo in place across a keyframe", "[Timeline]") {
+    const int steps = 70;
+    std::vector<Grid> expected = simulate(randomGrid(140, 80, 23), steps);
+    Game game(1, 1, 0);
+    game.getGrid() = expected[0];
+    for (int i = 0; i < steps; ++i) {
+        game.step();
+    }
+
+    // Allers-retours autour de l'image clé 32 : les deltas s'appliquent à la grille courante
+    game.seek(34);
+    for (int round = 0; round < 5; ++round) {
+        for (int generation = 33; generation >= 30; --generation) {
+            game.undo();
+            REQUIRE(sameCells(game.getGrid(), expected[generation]));
+        }
+        for (int generation = 31; generation <= 34; ++generation) {
+            game.redo();
+            REQUIRE(sameCells(game.getGrid(), expected[generation]));
+        }
+    }
+
+    // Grille modifiée depuis : reconstruite à partir d'une image clé
+    game.getGrid().toggleCellState(0, 0);
+    game.seek(20);
+    REQUIRE(sameCells(game.getGrid(), expected[20]));
+}
+
+TEST_CASE("Editing after an undo starts a branch", "[Timeline]") {
+    const int steps = 10;
+    std::vector<Grid> expected = simulate(randomGrid(100, 100, 24), steps);
+    Game game(1, 1, 0);
+    game.getGrid() = expected[0];
+    for (int i = 0; i < steps; ++i) {
+        game.step();
+    }
+    for (int i = 0; i < 3; ++i) {
+        game.undo();
+    }
+    REQUIRE(game.getTimelinePosition() == 7);
+    REQUIRE(game.getBranchCount() == 1);
+
+    // Génération 7 modifiée puis calculée : nouvelle branche à côté de l'ancienne
+    game.getGrid().toggleCellState(50, 50);
+    const Grid edited = game.getGrid();
+    game.step();
+    const Grid next = game.getGrid();
+    game.undo();
+    REQUIRE(sameCells(game.getGrid(), edited));
+    REQUIRE(game.getTimelinePosition() == 7);
+    REQUIRE(game.getBranchCount() == 2);
+    REQUIRE(game.getBranchIndex() == 1);
+    REQUIRE(game.getTimelineEnd() == 9);
+
+    // L'avenir abandonné est conservé dans la première branche
+    game.switchBranch(1);
+    REQUIRE(game.getBranchIndex() == 0);
+    REQUIRE(sameCells(game.getGrid(), expected[7]));
+    REQUIRE(game.getTimelineEnd() == static_cast<size_t>(steps) + 1);
+    game.seek(steps);
+    REQUIRE(sameCells(game.getGrid(), expected[steps]));
+
+    // PageUp/PageDown : retour à la branche modifiée, puis redo sur son chemin
+    game.seek(7);
+    game.switchBranch(-1);
+    REQUIRE(game.getBranchIndex() == 1);
+    REQUIRE(sameCells(game.getGrid(), edited));
+    game.redo();
+    REQUIRE(sameCells(game.getGrid(), next));
+    game.undo();
+    game.undo();
+    REQUIRE(sameCells(game.getGrid(), expected[6]));
+}
+
+TEST_CASE("History spilled under a tiny budget is read back", "[Timeline]") {
+    const Grid start = randomGrid(300, 200, 11);
+    Game game(1, 1, 0);
+    game.getGrid() = start;
+    game.setHistorySpill(true);
+    game.setHistoryBudget(96 * 1024);
+    const size_t steps = 120;
+    for (size_t i = 0; i < steps; ++i) {
+        game.step();
+    }
+    game.seek(0);  // Enregistre la dernière génération
+    REQUIRE(game.getHistoryDiskUsage() > 0);
+    REQUIRE(game.getTimelineBegin() == 0);
+    REQUIRE(game.getTimelineEnd() == steps + 1);
+
+    // Chaque génération relue, depuis la mémoire ou le disque, égale un calcul neuf
+    Grid expected = start;
+    for (size_t generation = 0; generation <= steps; ++generation) {
+        game.seek(generation);
+        INFO(generation);
+        REQUIRE(game.getTimelinePosition() == generation);
+        REQUIRE(sameCells(game.getGrid(), expected));
+        expected.update();
+    }
+    // Dans l'autre sens, une image clé déchargée sert de point de départ
+    game.seek(steps / 2 + 7);
+    Grid middle = start;
+    for (size_t i = 0; i < steps / 2 + 7; ++i) {
+        middle.update();
+    }
+    REQUIRE(sameCells(game.getGrid(), middle));
+}
+
+TEST_CASE("Spill file records read back before and after writing", "[Timeline]") {
+    SpillFile file;
+    REQUIRE(file.open());
+    std::vector<uint64_t> offsets;
+    for (int i = 0; i < 50; ++i) {
+        offsets.push_back(file.append(std::vector<uint8_t>(1000 + i, static_cast<uint8_t>(i))));
+    }
+    // Relecture immédiate : depuis la file d'attente ou le fichier
+    std::vector<uint8_t> out;
+    REQUIRE(file.read(offsets[49] + 10, 20, out));
+    REQUIRE(out == std::vector<uint8_t>(20, 49));
+    file.flush();
+    for (int i = 0; i < 50; ++i) {
+        REQUIRE(file.read(offsets[i], 1000 + i, out));
+        REQUIRE(out == std::vector<uint8_t>(1000 + i, static_cast<uint8_t>(i)));
+    }
+
+    file.reset();
+    REQUIRE(file.size() == 0);
+    REQUIRE(file.append(std::vector<uint8_t>(3, 7)) == 0);
+    file.flush();
+    REQUIRE(file.read(0, 3, out));
+    REQUIRE(out == std::vector<uint8_t>(3, 7));
+    REQUIRE(file.good());
+}
+
+#ifndef _WIN32
+TEST_CASE("Spill file usable again after a write error", "[Timeline]") {
+    SpillFile file;
+    REQUIRE(file.open());
+
+    // Fichiers limités à 4 Kio : l'écriture suivante échoue (EFBIG)
+    struct rlimit previous;
+    REQUIRE(::getrlimit(RLIMIT_FSIZE, &previous) == 0);
+    struct rlimit limit = previous;
+    limit.rlim_cur = 4096;
+    void (*handler)(int) = std::signal(SIGXFSZ, SIG_IGN);
+    REQUIRE(::setrlimit(RLIMIT_FSIZE, &limit) == 0);
+    uint64_t offset = file.append(std::vector<uint8_t>(10000, 1));
+    file.flush();
+    ::setrlimit(RLIMIT_FSIZE, &previous);
+    std::signal(SIGXFSZ, handler);
+
+    REQUIRE_FALSE(file.good());
+    // Les données refusées restent lisibles en mémoire
+    std::vector<uint8_t> out;
+    REQUIRE(file.read(offset, 10000, out));
+
+    file.reset();
+    REQUIRE(file.good());
+    REQUIRE(file.append(std::vector<uint8_t>(5000, 2)) == 0);
+    file.flush();
+    REQUIRE(file.good());
+    REQUIRE(file.read(0, 5000, out));
+    REQUIRE(out == std::vector<uint8_t>(5000, 2));
+}
+#endif
+
+TEST_CASE("Game without history records nothing", "[Console]") {
+    const int steps = 50;
+    std::vector<Grid> expected = simulate(randomGrid(120, 90, 25), steps);
+    Game game(1, 1, 0);
+    game.getGrid() = expected[0];
+    game.step();
+    REQUIRE(game.getHistoryMemoryUsage() > 0);
+
+    // Désactivé : l'historique existant est effacé et step() n'enregistre plus rien
+    game.setHistoryEnabled(false);
+    REQUIRE(game.getHistoryMemoryUsage() == 0);
+    for (int i = 1; i < steps; ++i) {
+        game.step();
+    }
+    REQUIRE(sameCells(game.getGrid(), expected[steps]));
+    REQUIRE(game.getIterations() == static_cast<uint64_t>(steps));
+    REQUIRE(game.getHistoryMemoryUsage() == 0);
+    REQUIRE(game.getHistoryDiskUsage() == 0);
+
+    // Undo et seek sont alors sans effet
+    game.undo();
+    game.seek(0);
+    REQUIRE(sameCells(game.getGrid(), expected[steps]));
+    REQUIRE(game.getHistoryMemoryUsage() == 0);
+}
+
+#ifndef _WIN32
+TEST_CASE("Console mode steps the requested generations", "[Console]") {
+    const int steps = 30;
+    std::vector<Grid> expected = simulate(randomGrid(60, 40, 26), steps);
+    const std::string input = "test_console_in.golb";
+    const std::string output = "test_console_out.golb";
+    REQUIRE(BinarySave::write(input, expected[0], 0));
+
+    ConsoleOptions options;
+    options.input = input;
+    options.output = output;
+    options.generations = steps;
+    options.speed = 0;
+
+    // Les images du terminal ne se mêlent pas au rapport des tests
+    std::cout.flush();
+    std::fflush(stdout);
+    int savedOutput = ::dup(STDOUT_FILENO);
+    int null = ::open("/dev/null", O_WRONLY);
+    ::dup2(null, STDOUT_FILENO);
+    int status = runConsoleMode(options);
+    std::cout.flush();
+    std::fflush(stdout);
+    ::dup2(savedOutput, STDOUT_FILENO);
+    ::close(null);
+    ::close(savedOutput);
+
+    REQUIRE(status == 0);
+    Grid loaded(1, 1);
+    uint64_t generation = 0;
+    REQUIRE(BinarySave::read(output, loaded, generation));
+    REQUIRE(generation == static_cast<uint64_t>(steps));
+    REQUIRE(sameCells(loaded, expected[steps]));
+    std::remove(input.c_str());
+    std::remove(output.c_str());
+}
+#endif
+
+TEST_CASE("Terminal frames without changes emit nothing", "[Console]") {
+    std::ostringstream output;
+    TerminalRenderer renderer(0, &output);
+    Grid grid = randomGrid(70, 20, 31);
+    REQUIRE(renderer.render(grid, "état", true));
+    REQUIRE(output.str().size() == renderer.getLastFrameBytes());
+    REQUIRE(output.str().find("\x1b[2J") != std::string::npos);
+
+    // Même grille, même ligne d'état : aucun octet
+    output.str("");
+    REQUIRE(renderer.render(grid, "état", true));
+    REQUIRE(renderer.getLastFrameBytes() == 0);
+    REQUIRE(output.str().empty());
+
+    // Une cellule changée : le curseur y est déplacé, seul son caractère est réécrit
+    grid.setCellCode(65, 10, grid.getCellCode(65, 10) == AliveCode ? DeadCode : AliveCode);
+    REQUIRE(renderer.render(grid, "état", true));
+    const char expected[] = {'\x1b', '[', '1', '2', ';', '6', '6', 'H',
+                             grid.getCellCode(65, 10) == AliveCode ? TerminalRenderer::AliveChar : TerminalRenderer::DeadChar};
+    REQUIRE(output.str() == std::string(expected, sizeof(expected)));
+
+    // Le mode réduit suit la même règle
+    renderer.setMode(TerminalRenderer::HalfBlocks);
+    REQUIRE(renderer.render(grid, "état", true));
+    output.str("");
+    REQUIRE(renderer.render(grid, "état", true));
+    REQUIRE(output.str().empty());
+}
+
+TEST_CASE("Braille characters map 2x4 cell blocks", "[Console]") {
+    std::ostringstream output;
+    TerminalRenderer renderer(0, &output);
+    renderer.setMode(TerminalRenderer::Braille);
+    Grid grid(16, 8);
+    // Premier caractère : points 1, 5 et 7 (motif 0x51) ; deuxième : les 8 points
+    grid.setCellCode(0, 0, AliveCode);
+    grid.setCellCode(1, 1, AliveCode);
+    grid.setCellCode(0, 3, AliveCode);
+    for (int y = 0; y < 4; ++y) {
+        grid.setCellCode(2, y, AliveCode);
+        grid.setCellCode(3, y, AliveCode);
+    }
+    // Sous le premier, rangée suivante : point 8 seul (colonne droite, dernière ligne)
+    grid.setCellCode(1, 7, AliveCode);
+    REQUIRE(renderer.render(grid, "", true));
+    REQUIRE(output.str().find("\x1b[2;1H\xE2\xA1\x91\xE2\xA3\xBF ") != std::string::npos);
+    REQUIRE(output.str().find("\x1b[3;1H\xE2\xA2\x80 ") != std::string::npos);
+
+    // Un point allumé : seul son caractère est réécrit (point 4, U+2808)
+    output.str("");
+    grid.setCellCode(5, 0, AliveCode);
+    REQUIRE(renderer.render(grid, "", true));
+    REQUIRE(output.str() == "\x1b[2;3H\xE2\xA0\x88");
+
+    // Zoom 2 : un point couvre 2 x 2 cellules, les 4 x 8 premières cellules tiennent
+    // dans un caractère (points 1, 2, 4, 5 et 7 : motif 0x5B), la cellule (5, 0)
+    // allume le point 1 du suivant
+    renderer.setZoom(2);
+    output.str("");
+    REQUIRE(renderer.render(grid, "", true));
+    REQUIRE(output.str().find("\x1b[2;1H\xE2\xA1\x9B\xE2\xA0\x81 ") != std::string::npos);
+}
+
+TEST_CASE("Metrics stream writes sampled generations", "[Metrics]") {
+    const int steps = 40;
+    std::vector<Grid> expected = simulate(randomGrid(100, 80, 27), steps);
+    const std::string path = "test_metrics.csv";
+    Game game(1, 1, 0);
+    game.getGrid() = expected[0];
+    REQUIRE(game.startMetrics(path, 5));
+    for (int i = 0; i < steps; ++i) {
+        game.step();
+    }
+    REQUIRE(game.stopMetrics());
+
+    std::istringstream lines(readText(path));
+    std::string line;
+    REQUIRE(std::getline(lines, line));
+    REQUIRE(line == "generation,population,naissances,morts,tuiles_modifiees,duree_calcul_us");
+    int generation = 0;
+    while (std::getline(lines, line)) {
+        generation += 5;
+        unsigned long long values[5];
+        double micros = -1;
+        INFO(line);
+        REQUIRE(std::sscanf(line.c_str(), "%llu,%llu,%llu,%llu,%llu,%lf", &values[0], &values[1], &values[2],
+                            &values[3], &values[4], &micros) == 6);
+        int created, destroyed;
+        expected[generation].countChanges(expected[generation - 1], created, destroyed);
+        REQUIRE(values[0] == static_cast<unsigned long long>(generation));
+        REQUIRE(values[1] == static_cast<unsigned long long>(expected[generation].countAlive()));
+        REQUIRE(values[2] == static_cast<unsigned long long>(created));
+        REQUIRE(values[3] == static_cast<unsigned long long>(destroyed));
+        REQUIRE(micros >= 0);
+    }
+    REQUIRE(generation == steps);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Metrics stream of a batch run in JSON lines", "[Metrics]") {
+    const std::string input = "test_metrics_in.golb";
+    const std::string path = "test_metrics.jsonl";
+    std::vector<Grid> expected = simulate(randomGrid(90, 90, 28), 3);
+    REQUIRE(BinarySave::write(input, expected[0], 10));
+
+    // Le mode batch relève les mêmes statistiques que Game::step()
+    BatchRun::Options options;
+    options.input = input;
+    options.generations = 3;
+    options.maxPeriod = 0;
+    options.metrics = path;
+    BatchRun::Summary summary;
+    REQUIRE(BatchRun::run(options, summary));
+
+    std::istringstream lines(readText(path));
+    std::string line;
+    for (int i = 1; i <= 3; ++i) {
+        REQUIRE(std::getline(lines, line));
+        std::string prefix = "{\"generation\":" + std::to_string(10 + i) +
+                             ",\"population\":" + std::to_string(expected[i].countAlive()) + ",";
+        INFO(line);
+        REQUIRE(line.compare(0, prefix.size(), prefix) == 0);
+        REQUIRE(line.back() == '}');
+    }
+    REQUIRE_FALSE(std::getline(lines, line));
+    std::remove(input.c_str());
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Lock-free queue keeps the producer's order", "[Metrics]") {
+    // Capacité arrondie à la puissance de 2 supérieure
+    SpscQueue<int> small(5);
+    for (int i = 0; i < 8; ++i) {
+        REQUIRE(small.push(i));
+    }
+    REQUIRE_FALSE(small.push(8));
+    int value = -1;
+    for (int i = 0; i < 8; ++i) {
+        REQUIRE(small.pop(value));
+        REQUIRE(value == i);
+    }
+    REQUIRE_FALSE(small.pop(value));
+    REQUIRE(small.empty());
+
+    // Un producteur et un consommateur concurrents, file souvent pleine
+    const int count = 200000;
+    SpscQueue<int> queue(16);
+    std::thread producer([&] {
+        for (int i = 0; i < count; ++i) {
+            while (!queue.push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    int expected = 0;
+    bool ordered = true;
+    while (expected < count) {
+        if (queue.pop(value)) {
+            ordered = ordered && value == expected;
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    REQUIRE(ordered);
+    REQUIRE(queue.empty());
+}
+
+TEST_CASE("Batch mode detects stable and periodic states", "[Batch]") {
+    const std::string input = "test_batch.golb";
+    struct Case {
+        const char* name;
+        std::vector<std::pair<int, int>> cells;
+        bool toroidal;
+        uint64_t period;
+        uint64_t generations;
+        const char* end;
+    };
+    const Case cases[] = {
+        {"bloc", {{3, 3}, {4, 3}, {3, 4}, {4, 4}}, false, 1, 1, "fin=stable"},
+        {"clignotant", {{5, 4}, {5, 5}, {5, 6}}, false, 2, 2, "fin=periodique"},
+        // Un planeur revient à sa place sur un tore de 8 x 8 après 32 générations
+        {"planeur sur un tore", {{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}}, true, 32, 32, "fin=periodique"},
+        {"planeur", {{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}}, false, 0, 20, "fin=limite"},
+    };
+    for (const Case& c : cases) {
+        Grid grid(c.toroidal ? 8 : 40, c.toroidal ? 8 : 40);
+        grid.setToroidal(c.toroidal);
+        for (const auto& cell : c.cells) {
+            grid.setCellCode(cell.first, cell.second, AliveCode);
+        }
+        REQUIRE(BinarySave::write(input, grid, 0));
+
+        BatchRun::Options options;
+        options.input = input;
+        options.generations = 20 + 2 * c.period;
+        BatchRun::Summary summary;
+        INFO(c.name);
+        REQUIRE(BatchRun::run(options, summary));
+        REQUIRE(summary.period == c.period);
+        REQUIRE(summary.generations == (c.period != 0 ? c.generations : options.generations));
+        std::ostringstream out;
+        BatchRun::printSummary(summary, out);
+        REQUIRE(out.str().find(c.end) != std::string::npos);
+    }
+    std::remove(input.c_str());
+}